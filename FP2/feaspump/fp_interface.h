@@ -35,6 +35,12 @@ public:
 	 * Read needed information (if any) about the problem (@param pinfo)
 	 */
 	virtual void init(const dominiqs::Model& model, bool ignoreGeneralInt = true) {}
+	/**
+	 * Initialize from @param other, an already initialized transformer of the same type,
+	 * sharing with it all the read-only data (if possible).
+	 * @return false if this is not supported: init() must be called instead
+	 */
+	virtual bool initFrom(const SolutionTransformer& other, bool ignoreGeneralInt = true) { return false; }
 	virtual void ignoreGeneralIntegers(bool flag) {}
 	/**
 	 * Trasform the vector given as input @param in and store the result in @param out
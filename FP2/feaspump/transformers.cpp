@@ -17,6 +17,10 @@
 #include <algorithm>
 #include <boost/format.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <utils/floats.h>
 #include <utils/xmlconfig.h>
 #include <utils/logger.h>
@@ -107,8 +111,19 @@ void SimpleRounding::apply(const std::vector<double>& in, std::vector<double>& o
 	);
 }
 
-PropagatorRounding::PropagatorRounding() : state(0)
+static bool DEF_PROBING = false;
+static double DEF_PROBING_TIME_LIMIT = 10.0;
+static double DEF_PROBING_MAX_MEMORY = 64.0;
+static bool DEF_COMPONENT_PARALLEL = false;
+static int DEF_COMPONENT_THREADS = 0;
+static const int COMPONENT_BUCKETS_PER_THREAD = 4;
+
+PropagatorRounding::PropagatorRounding() : state(0), probing(DEF_PROBING),
+	probingTimeLimit(DEF_PROBING_TIME_LIMIT), probingMaxMemory(DEF_PROBING_MAX_MEMORY),
+	componentParallel(DEF_COMPONENT_PARALLEL), componentThreads(DEF_COMPONENT_THREADS)
 {
+	// all rounders in the process share the same (interned) variable names
+	domain.setNameTable(VarNameTable::shared());
 }
 
 void PropagatorRounding::readConfig()
@@ -116,9 +131,19 @@ void PropagatorRounding::readConfig()
 	SimpleRounding::readConfig();
 	std::string rankerName = gConfig().get("FeasibilityPump", "ranker", std::string("FRAC"));
 	filterConstraints = gConfig().get("FeasibilityPump", "filterConstraints", true);
+	READ_FROM_CONFIG( probing, DEF_PROBING );
+	READ_FROM_CONFIG( probingTimeLimit, DEF_PROBING_TIME_LIMIT );
+	READ_FROM_CONFIG( probingMaxMemory, DEF_PROBING_MAX_MEMORY );
+	READ_FROM_CONFIG( componentParallel, DEF_COMPONENT_PARALLEL );
+	READ_FROM_CONFIG( componentThreads, DEF_COMPONENT_THREADS );
 	LOG_START_SECTION("config");
 	LOG_ITEM("ranker", rankerName);
 	LOG_ITEM("filterConstraints", filterConstraints);
+	LOG_CONFIG( probing );
+	LOG_CONFIG( probingTimeLimit );
+	LOG_CONFIG( probingMaxMemory );
+	LOG_CONFIG( componentParallel );
+	LOG_CONFIG( componentThreads );
 	LOG_END_SECTION();
 	ranker = RankerPtr(RankerFactory::getInstance().create(rankerName));
 	ranker->readConfig();
@@ -127,6 +152,8 @@ void PropagatorRounding::readConfig()
 void PropagatorRounding::init(const dominiqs::Model& model, bool ignoreGeneralInt)
 {
 	SimpleRounding::init(model, ignoreGeneralInt);
+	// independent blocks are rounded by their own rounders
+	if (componentParallel && buildComponents(model, ignoreGeneralInt)) return;
 	// add vars to domain
 	for (unsigned int j = 0; j < model.numVars; j++) domain.pushVar(model.xNames[j], model.xType[j], model.xLb[j], model.xUb[j]);
 	// connect domain to engine and ranker
@@ -183,6 +210,7 @@ void PropagatorRounding::init(const dominiqs::Model& model, bool ignoreGeneralIn
 		// try analyzers
 		while (itr != end)
 		{
+			if (itr->second->absorb(&domain, c)) break;
 			Propagator* p = itr->second->analyze(&domain, c);
 			if (p)
 			{
@@ -192,10 +220,18 @@ void PropagatorRounding::init(const dominiqs::Model& model, bool ignoreGeneralIn
 			itr++;
 		}
 	}
-	// log prop stats
-	//std::cout << std::endl << "Propagators:" << std::endl;
+	// global propagators (built from the constraints absorbed by their factories)
 	std::map<int, PropagatorFactoryPtr>::iterator itr = factories.begin();
 	std::map<int, PropagatorFactoryPtr>::iterator end = factories.end();
+	while (itr != end)
+	{
+		Propagator* p = itr->second->finalize(&domain);
+		if (p) prop.pushPropagator(p);
+		++itr;
+	}
+	// log prop stats
+	//std::cout << std::endl << "Propagators:" << std::endl;
+	itr = factories.begin();
 	//while (itr != end)
 	//{
 		//std::cout << itr->second->getName() << " " << itr->second->created() << std::endl;
@@ -207,17 +243,262 @@ void PropagatorRounding::init(const dominiqs::Model& model, bool ignoreGeneralIn
 	// prop.propagate();
 	state = prop.getStateMgr();
 	state->dump();
+	if (probing) probe();
+}
+
+void PropagatorRounding::probe()
+{
+	Chrono chrono(true);
+	boost::shared_ptr<ImplicationTable> table(new ImplicationTable());
+	double maxEntries = probingMaxMemory * 1024.0 * 1024.0 / (sizeof(int) + sizeof(char));
+	unsigned int n = domain.size();
+	unsigned int probed = 0;
+	bool stop = false;
+	table->beg.reserve(2 * n + 1);
+	table->status.reserve(2 * n);
+	table->beg.push_back(0);
+	for (unsigned int j = 0; j < n; j++)
+	{
+		for (int v = 0; v < 2; v++)
+		{
+			char status = ImplicationTable::NOT_PROBED;
+			if (!stop && (domain.varType(j) == 'B') && !domain.isVarFixed(j))
+			{
+				state->restore();
+				if (prop.propagate(j, v))
+				{
+					for (int i: prop.getLastFixed())
+					{
+						if ((i == (int)j) || (domain.varType(i) != 'B')) continue;
+						table->var.push_back(i);
+						table->val.push_back(domain.varLb(i) > 0.5);
+					}
+					status = ImplicationTable::PROBED;
+				}
+				else status = ImplicationTable::INFEASIBLE;
+				probed++;
+				stop = (chrono.getWallElapsed() > probingTimeLimit) || (table->var.size() > maxEntries);
+			}
+			table->status.push_back(status);
+			table->beg.push_back(table->var.size());
+		}
+	}
+	state->restore();
+	// probing is not counted in the propagators statistics
+	for (std::map<int, PropagatorFactoryPtr>::iterator itr = factories.begin(); itr != factories.end(); ++itr) itr->second->reset();
+	implications = table;
+	LOG_START_SECTION("probing");
+	LOG_ITEM("time", chrono.getWallElapsed());
+	LOG_ITEM("probed", probed);
+	LOG_ITEM("implications", table->var.size());
+	LOG_ITEM("complete", !stop);
+	LOG_END_SECTION();
+}
+
+bool PropagatorRounding::initFrom(const SolutionTransformer& other, bool ignoreGeneralInt)
+{
+	const PropagatorRounding* master = dynamic_cast<const PropagatorRounding*>(&other);
+	if (!master || (!master->state && master->components.empty())) return false;
+	// same variables (and same name table) of the master
+	binaries = master->binaries;
+	gintegers = master->gintegers;
+	ignoreGeneralIntegers(ignoreGeneralInt);
+	if (!master->components.empty())
+	{
+		// one rounder per component, each sharing the structure of the master's one
+		componentCols = master->componentCols;
+		componentIn = master->componentIn;
+		componentOut = master->componentOut;
+		componentThreads = master->componentThreads;
+		uint64_t seed = gConfig().get<uint64_t>("Globals", "seed", DEF_SEED);
+		for (unsigned int b = 0; b < master->components.size(); b++)
+		{
+			boost::shared_ptr<PropagatorRounding> sub(new PropagatorRounding());
+			sub->readConfig();
+			sub->componentParallel = false;
+			sub->roundGen.setSeed(seed + b + 1);
+			sub->roundGen.warmUp();
+			if (!sub->initFrom(*(master->components[b]), ignoreGeneralInt)) return false;
+			components.push_back(sub);
+		}
+		return true;
+	}
+	domain.clear();
+	domain.setNameTable(master->domain.getNameTable());
+	for (unsigned int j = 0; j < master->domain.size(); j++)
+	{
+		domain.pushVar(master->domain.varName(j), master->domain.varType(j), master->domain.varLb(j), master->domain.varUb(j));
+	}
+	prop.setDomain(&domain);
+	ranker->init(&domain, ignoreGeneralInt);
+	// our own factories (they keep per-thread statistics)
+	std::map<const PropagatorFactory*, PropagatorFactory*> factoryMap;
+	std::map<int, PropagatorFactoryPtr>::const_iterator itr = master->factories.begin();
+	std::map<int, PropagatorFactoryPtr>::const_iterator end = master->factories.end();
+	while (itr != end)
+	{
+		PropagatorFactoryPtr fact(itr->second->clone());
+		factories[itr->first] = fact;
+		factoryMap[itr->second.get()] = fact.get();
+		++itr;
+	}
+	// propagators share the row structure with the master ones
+	for (Propagator* mp: master->prop.getPropagators())
+	{
+		Propagator* p = mp->clone(&domain, factoryMap[mp->getFactory()]);
+		if (!p) throw std::runtime_error(std::string("Propagator cannot be shared: ") + mp->getName());
+		p->setPriority(mp->getPriority());
+		prop.pushPropagator(p);
+	}
+	state = prop.getStateMgr();
+	state->dump();
+	implications = master->implications;
+	return true;
+}
+
+bool PropagatorRounding::buildComponents(const dominiqs::Model& model, bool ignoreGeneralInt)
+{
+	// connected components of the variable-constraint graph (union-find)
+	unsigned int n = model.numVars;
+	std::vector<int> parent(n);
+	dominiqs::iota(parent.begin(), parent.end(), 0);
+	auto find = [&parent](int j) {
+		while (parent[j] != j) { parent[j] = parent[parent[j]]; j = parent[j]; }
+		return j;
+	};
+	for (unsigned int i = 0; i < model.numRows; i++)
+	{
+		const Constraint* c = model.rows[i].get();
+		const int* idx = c->row.idx();
+		unsigned int size = c->row.size();
+		for (unsigned int k = 1; k < size; k++)
+		{
+			int r1 = find(idx[0]);
+			int r2 = find(idx[k]);
+			if (r1 != r2) parent[r2] = r1;
+		}
+	}
+	std::map<int, std::vector<int> > blocks;
+	for (unsigned int j = 0; j < n; j++) blocks[find(j)].push_back(j);
+	LOG_START_SECTION("components");
+	LOG_ITEM("count", blocks.size());
+	LOG_END_SECTION();
+	if (blocks.size() < 2) return false;
+	// pack the components into a few buckets of similar size (largest first)
+	int nThreads = componentThreads;
+#ifdef _OPENMP
+	if (nThreads <= 0) nThreads = omp_get_max_threads();
+#endif
+	nThreads = std::max(nThreads, 1);
+	unsigned int numBuckets = std::min((unsigned int)blocks.size(), (unsigned int)(nThreads * COMPONENT_BUCKETS_PER_THREAD));
+	std::vector< const std::vector<int>* > bySize;
+	for (std::map<int, std::vector<int> >::const_iterator itr = blocks.begin(); itr != blocks.end(); ++itr) bySize.push_back(&(itr->second));
+	std::stable_sort(bySize.begin(), bySize.end(), [](const std::vector<int>* a, const std::vector<int>* b) { return a->size() > b->size(); });
+	componentCols.assign(numBuckets, std::vector<int>());
+	for (const std::vector<int>* block: bySize)
+	{
+		unsigned int lightest = 0;
+		for (unsigned int b = 1; b < numBuckets; b++)
+		{
+			if (componentCols[b].size() < componentCols[lightest].size()) lightest = b;
+		}
+		componentCols[lightest].insert(componentCols[lightest].end(), block->begin(), block->end());
+	}
+	// build a sub-model (with local column indices) and a rounder for each bucket
+	std::vector<int> bucketOf(n);
+	std::vector<int> localIdx(n);
+	for (unsigned int b = 0; b < numBuckets; b++)
+	{
+		std::sort(componentCols[b].begin(), componentCols[b].end());
+		for (unsigned int k = 0; k < componentCols[b].size(); k++)
+		{
+			bucketOf[componentCols[b][k]] = b;
+			localIdx[componentCols[b][k]] = k;
+		}
+	}
+	std::vector<dominiqs::Model> subModels(numBuckets);
+	for (unsigned int b = 0; b < numBuckets; b++)
+	{
+		dominiqs::Model& sub = subModels[b];
+		sub.numVars = componentCols[b].size();
+		sub.numRows = 0;
+		for (int j: componentCols[b])
+		{
+			sub.xLb.push_back(model.xLb[j]);
+			sub.xUb.push_back(model.xUb[j]);
+			sub.xType.push_back(model.xType[j]);
+			sub.xNames.push_back(model.xNames[j]);
+		}
+	}
+	for (unsigned int i = 0; i < model.numRows; i++)
+	{
+		const Constraint* c = model.rows[i].get();
+		const int* idx = c->row.idx();
+		const double* coef = c->row.coef();
+		unsigned int size = c->row.size();
+		if (!size) continue;
+		dominiqs::Model& sub = subModels[bucketOf[idx[0]]];
+		CutPtr r(new Cut());
+		r->name = c->name;
+		r->sense = c->sense;
+		r->rhs = c->rhs;
+		for (unsigned int k = 0; k < size; k++) r->row.push(localIdx[idx[k]], coef[k]);
+		sub.rows.push_back(r);
+		sub.numRows++;
+	}
+	uint64_t seed = gConfig().get<uint64_t>("Globals", "seed", DEF_SEED);
+	componentIn.resize(numBuckets);
+	componentOut.resize(numBuckets);
+	for (unsigned int b = 0; b < numBuckets; b++)
+	{
+		boost::shared_ptr<PropagatorRounding> sub(new PropagatorRounding());
+		sub->readConfig();
+		sub->componentParallel = false;
+		// the buckets are probed one after the other: split the probing budget by their size
+		double share = (double)componentCols[b].size() / (double)n;
+		sub->probingTimeLimit = probingTimeLimit * share;
+		sub->probingMaxMemory = probingMaxMemory * share;
+		sub->roundGen.setSeed(seed + b + 1);
+		sub->roundGen.warmUp();
+		sub->init(subModels[b], ignoreGeneralInt);
+		components.push_back(sub);
+		componentIn[b].resize(componentCols[b].size());
+		componentOut[b].resize(componentCols[b].size());
+	}
+	componentThreads = nThreads;
+	return true;
 }
 
 void PropagatorRounding::ignoreGeneralIntegers(bool flag)
 {
 	SimpleRounding::ignoreGeneralIntegers(flag);
-	ranker->ignoreGeneralIntegers(flag);
+	if (ranker) ranker->ignoreGeneralIntegers(flag);
+	for (unsigned int b = 0; b < components.size(); b++) components[b]->ignoreGeneralIntegers(flag);
 }
 
 void PropagatorRounding::apply(const std::vector<double>& in, std::vector<double>& out)
 {
 	copy(in.begin(), in.end(), out.begin());
+	if (!components.empty())
+	{
+		// components are independent: each one is rounded and propagated by its own
+		// rounder (with its own domain and queue). Note that, if we are already inside
+		// a parallel region, this runs in parallel only if nested parallelism is enabled.
+		int numBuckets = components.size();
+		#ifdef _OPENMP
+		#pragma omp parallel for schedule(dynamic) num_threads(componentThreads)
+		#endif
+		for (int b = 0; b < numBuckets; b++)
+		{
+			const std::vector<int>& cols = componentCols[b];
+			std::vector<double>& subIn = componentIn[b];
+			std::vector<double>& subOut = componentOut[b];
+			for (unsigned int k = 0; k < cols.size(); k++) subIn[k] = in[cols[k]];
+			components[b]->apply(subIn, subOut);
+			for (unsigned int k = 0; k < cols.size(); k++) out[cols[k]] = subOut[k];
+		}
+		return;
+	}
 	state->restore();
 	double t = getRoundingThreshold(randomizedRounding, roundGen);
 	ranker->setCurrentState(in);
@@ -236,7 +517,24 @@ void PropagatorRounding::apply(const std::vector<double>& in, std::vector<double
 			else doRound(in[next], out[next], t);
 		}
 		// propagate
-		prop.propagate(next, out[next]);
+		int v = (out[next] > 0.5);
+		if (implications && (domain.varType(next) == 'B') &&
+			(implications->status[implications->key(next, v)] == ImplicationTable::PROBED))
+		{
+			// apply the cached consequences in bulk, then go on with incremental propagation
+			int k = implications->key(next, v);
+			bulkVars.clear();
+			bulkValues.clear();
+			bulkVars.push_back(next);
+			bulkValues.push_back(out[next]);
+			for (int h = implications->beg[k]; h < implications->beg[k + 1]; h++)
+			{
+				bulkVars.push_back(implications->var[h]);
+				bulkValues.push_back(implications->val[h]);
+			}
+			prop.propagate(bulkVars, bulkValues);
+		}
+		else prop.propagate(next, out[next]);
 		DOMINIQS_ASSERT( domain.isVarFixed(next) );
 		// update with fixings
 		for (int j: prop.getLastFixed()) out[j] = domain.varLb(j);
@@ -256,8 +554,13 @@ void PropagatorRounding::clear()
 	}
 	// clear
 	delete state;
+	state = 0;
 	prop.clear();
 	factories.clear();
+	components.clear();
+	componentCols.clear();
+	componentIn.clear();
+	componentOut.clear();
 }
 
 // auto registration
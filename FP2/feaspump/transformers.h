@@ -56,6 +56,24 @@ public:
 	bool logDetails;
 };
 
+/**
+ * Implications found by probing the binaries at init time:
+ * for each binary x_j and value v, the binaries fixed by propagating x_j = v.
+ * It is read-only and shared among threads.
+ */
+
+struct ImplicationTable
+{
+	enum ProbeStatus { NOT_PROBED = 0, PROBED = 1, INFEASIBLE = 2 };
+	inline int key(int j, int v) const { return (2 * j + v); }
+	std::vector<int> beg; //< beg[key(j,v)]..beg[key(j,v)+1] are the implications of x_j = v
+	std::vector<int> var;
+	std::vector<char> val;
+	std::vector<char> status; //< ProbeStatus of each (j,v)
+};
+
+typedef boost::shared_ptr<const ImplicationTable> ImplicationTablePtr;
+
 /**
  * Ranked rounding + constraint propagation
  */
@@ -67,6 +85,7 @@ public:
 	~PropagatorRounding() { clear(); }
 	void readConfig();
 	void init(const dominiqs::Model& model, bool ignoreGeneralInt = true);
+	bool initFrom(const dominiqs::SolutionTransformer& other, bool ignoreGeneralInt = true);
 	void ignoreGeneralIntegers(bool flag);
 	void apply(const std::vector<double>& in, std::vector<double>& out);
 	void clear();
@@ -79,6 +98,22 @@ public:
 	std::map<int, PropagatorFactoryPtr> factories;
 	RankerPtr ranker;
 	bool filterConstraints;
+	// probing
+	bool probing;
+	double probingTimeLimit; //< in seconds (wall clock)
+	double probingMaxMemory; //< in MB
+	ImplicationTablePtr implications;
+	std::vector<int> bulkVars;
+	std::vector<double> bulkValues;
+	void probe();
+	// component-parallel rounding
+	bool componentParallel;
+	int componentThreads; //< 0 = all available
+	std::vector< boost::shared_ptr<PropagatorRounding> > components;
+	std::vector< std::vector<int> > componentCols; //< local -> global column index
+	std::vector< std::vector<double> > componentIn;
+	std::vector< std::vector<double> > componentOut;
+	bool buildComponents(const dominiqs::Model& model, bool ignoreGeneralInt);
 };
 
 #endif /* TRANSFORMERS_H */
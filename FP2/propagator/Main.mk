@@ -4,7 +4,7 @@ include ${CURDIR}/make/Header.mk
 # C/C++rules
 $(call OBJ_CPP_RULE,${SUB_BUILDIR},${SUB_DIR})
 
-SOURCES		:= domain.cpp propagator.cpp prop_engine.cpp linear_propagator.cpp varbound_propagator.cpp logic_propagator.cpp
+SOURCES		:= domain.cpp propagator.cpp prop_engine.cpp linear_propagator.cpp varbound_propagator.cpp logic_propagator.cpp clique_propagator.cpp
 TARGET		:= libprop.${STATICLIBEXT}
 
 DEPS            := libutils.${STATICLIBEXT}
@@ -0,0 +1,351 @@
+/**
+ * @file clique_propagator.cpp
+ * @brief Clique (conflict graph) propagator
+ *
+ * @author Domenico Salvagnin dominiqs@gmail.com
+ * 2008-2012
+ */
+
+#include <boost/format.hpp>
+#include <algorithm>
+#include <iostream>
+
+#include <utils/floats.h>
+
+#include "clique_propagator.h"
+#include "advisors.h"
+
+using boost::format;
+using namespace dominiqs;
+
+static const int CLIQUE_DEFAULT_PRIORITY = 500;
+
+/**
+ * Advise for fixings of a variable belonging to (at least) one clique
+ */
+
+class CliqueAdvisor : public AdvisorI
+{
+public:
+	CliqueAdvisor(CliqueProp* p, int j) : AdvisorI(p, j) {}
+	// events for binary variables
+	void fixedUp()
+	{
+		if (prop->getState() != CSTATE_UNKNOWN) return;
+		getMyProp<CliqueProp>()->fixedUp(var);
+	}
+	void fixedDown()
+	{
+		if (prop->getState() != CSTATE_UNKNOWN) return;
+		getMyProp<CliqueProp>()->fixedDown(var);
+	}
+	// output
+	std::ostream& print(std::ostream& out) const
+	{
+		return out << format("adv(%1%, idx=%2%)") % prop->getName() % var;
+	}
+};
+
+class CliquePropState : public State
+{
+public:
+	CliquePropState(CliqueProp* p) : prop(p), state(CSTATE_UNKNOWN) {}
+	CliquePropState* clone() const
+	{
+		return new CliquePropState(*this);
+	}
+	void dump()
+	{
+		oneVar = prop->oneVar;
+		numZeros = prop->numZeros;
+		state = prop->state;
+	}
+	void restore()
+	{
+		prop->oneVar = oneVar;
+		prop->numZeros = numZeros;
+		prop->pendingVars.clear();
+		prop->pendingCliques.clear();
+		prop->state = state;
+		prop->dirty = false;
+	}
+protected:
+	CliqueProp* prop;
+	std::vector<int> oneVar;
+	std::vector<int> numZeros;
+	PropagatorState state;
+};
+
+CliqueProp::CliqueProp(Domain* d, PropagatorFactory* fact, CliqueTablePtr _table) : Propagator(d, fact), table(_table)
+{
+	DOMINIQS_ASSERT( domain );
+	DOMINIQS_ASSERT( table );
+	DOMINIQS_ASSERT( table->varBeg.size() == (domain->size() + 1) );
+	name = "cliques";
+	oneVar.resize(table->numCliques(), -1);
+	numZeros.resize(table->numCliques(), 0);
+	dirty = false;
+	unsigned int n = domain->size();
+	for (unsigned int j = 0; (j < n) && (state == CSTATE_UNKNOWN); j++)
+	{
+		if ((table->varBeg[j] == table->varBeg[j + 1]) || !domain->isVarFixed(j)) continue;
+		if (isNull(domain->varLb(j))) fixedDown(j);
+		else fixedUp(j);
+	}
+	setPriority(CLIQUE_DEFAULT_PRIORITY);
+}
+
+Propagator* CliqueProp::clone(Domain* d, PropagatorFactory* fact) const
+{
+	return new CliqueProp(d, fact, table);
+}
+
+void CliqueProp::createAdvisors(std::list<AdvisorI*>& advisors)
+{
+	unsigned int n = domain->size();
+	for (unsigned int j = 0; j < n; j++)
+	{
+		if (table->varBeg[j] < table->varBeg[j + 1]) advisors.push_back(new CliqueAdvisor(this, j));
+	}
+}
+
+void CliqueProp::fixedUp(int j)
+{
+	for (int t = table->varBeg[j]; t < table->varBeg[j + 1]; t++)
+	{
+		int k = table->varCliques[t];
+		if (oneVar[k] >= 0)
+		{
+			// two variables at one in the same clique
+			state = CSTATE_INFEAS;
+			dirty = false;
+			return;
+		}
+		oneVar[k] = j;
+	}
+	pendingVars.push_back(j);
+	dirty = true;
+}
+
+void CliqueProp::fixedDown(int j)
+{
+	for (int t = table->varBeg[j]; t < table->varBeg[j + 1]; t++)
+	{
+		int k = table->varCliques[t];
+		if (!table->isPartition[k]) continue;
+		numZeros[k]++;
+		if (oneVar[k] >= 0) continue;
+		int size = table->cliqueBeg[k + 1] - table->cliqueBeg[k];
+		if (numZeros[k] == size)
+		{
+			// all variables at zero in a partitioning clique
+			state = CSTATE_INFEAS;
+			dirty = false;
+			return;
+		}
+		if (numZeros[k] == (size - 1))
+		{
+			pendingCliques.push_back(k);
+			dirty = true;
+		}
+	}
+}
+
+void CliqueProp::propagate()
+{
+	if (dirty == false) return;
+	factory->propCalled()++;
+	// note that our own fixings are notified back to us by the advisors,
+	// so that the pending lists can grow while we are processing them
+	while ((state == CSTATE_UNKNOWN) && (!pendingVars.empty() || !pendingCliques.empty()))
+	{
+		if (!pendingVars.empty())
+		{
+			// fix to zero all the neighbours of j in the conflict graph
+			int j = pendingVars.back();
+			pendingVars.pop_back();
+			for (int t = table->varBeg[j]; (t < table->varBeg[j + 1]) && (state == CSTATE_UNKNOWN); t++)
+			{
+				int k = table->varCliques[t];
+				for (int u = table->cliqueBeg[k]; (u < table->cliqueBeg[k + 1]) && (state == CSTATE_UNKNOWN); u++)
+				{
+					int i = table->cliqueVars[u];
+					if ((i == j) || domain->isVarFixed(i)) continue;
+					domain->fixBinDown(i);
+					factory->domainReductions()++;
+				}
+			}
+		}
+		else
+		{
+			// a single free variable left in a partitioning clique: fix it to one
+			int k = pendingCliques.back();
+			pendingCliques.pop_back();
+			if (oneVar[k] >= 0) continue;
+			for (int u = table->cliqueBeg[k]; u < table->cliqueBeg[k + 1]; u++)
+			{
+				int i = table->cliqueVars[u];
+				if (domain->isVarFixed(i)) continue;
+				domain->fixBinUp(i);
+				factory->domainReductions()++;
+				break;
+			}
+		}
+	}
+	pendingVars.clear();
+	pendingCliques.clear();
+	dirty = false; // at the end: this is monotonic
+}
+
+StatePtr CliqueProp::getStateMgr()
+{
+	return new CliquePropState(this);
+}
+
+std::ostream& CliqueProp::print(std::ostream& out) const
+{
+	return out << format("CliqueProp(%1%, %2%, cliques=%3%)")
+		% name % PropagatorStateName[state] % table->numCliques();
+}
+
+PropagatorFactory* CliqueFactory::clone() const
+{
+	return new CliqueFactory();
+}
+
+int CliqueFactory::getPriority() const
+{
+	return CLIQUE_DEFAULT_PRIORITY;
+}
+
+const char* CliqueFactory::getName() const
+{
+	return "clique";
+}
+
+Propagator* CliqueFactory::analyze(Domain* d, Constraint* c)
+{
+	// rows are collected by absorb()
+	return 0;
+}
+
+bool CliqueFactory::absorb(Domain* d, Constraint* c)
+{
+	const int* idx = c->row.idx();
+	const double* coef = c->row.coef();
+	unsigned int size = c->row.size();
+	if (size < 2) return false;
+	// accept sum x <= 1, sum x = 1 and their negated versions
+	double sign = (coef[0] > 0.0) ? 1.0 : -1.0;
+	for (unsigned int k = 0; k < size; k++)
+	{
+		if (d->varType(idx[k]) != 'B') return false;
+		if (different(coef[k], sign)) return false;
+	}
+	double rhs = sign * c->rhs;
+	char sense = c->sense;
+	if (sign < 0.0)
+	{
+		if (sense == 'L') sense = 'G';
+		else if (sense == 'G') sense = 'L';
+	}
+	bool isPacking = (sense == 'L') && equal(floorEps(rhs), 1.0);
+	bool isPartitioning = (sense == 'E') && equal(rhs, 1.0);
+	if (!isPacking && !isPartitioning) return false;
+	cliques.push_back(std::vector<int>(idx, idx + size));
+	std::sort(cliques.back().begin(), cliques.back().end());
+	partition.push_back(isPartitioning);
+	return true;
+}
+
+/**
+ * Order cliques by decreasing size, then lexicographically
+ */
+
+class CliqueCompare
+{
+public:
+	CliqueCompare(const std::vector< std::vector<int> >& c) : cliques(c) {}
+	bool operator()(int a, int b) const
+	{
+		if (cliques[a].size() != cliques[b].size()) return (cliques[a].size() > cliques[b].size());
+		return (cliques[a] < cliques[b]);
+	}
+protected:
+	const std::vector< std::vector<int> >& cliques;
+};
+
+Propagator* CliqueFactory::finalize(Domain* d)
+{
+	if (cliques.empty()) return 0;
+	unsigned int n = d->size();
+	// merge the cliques: duplicates are removed, as well as packing cliques
+	// contained in a larger one (larger cliques come first in this order)
+	std::vector<int> order(cliques.size());
+	iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), CliqueCompare(cliques));
+	std::vector<int> kept;
+	std::vector< std::vector<int> > varKept(n);
+	for (unsigned int h = 0; h < order.size(); h++)
+	{
+		int k = order[h];
+		const std::vector<int>& K = cliques[k];
+		if (!kept.empty() && (cliques[kept.back()] == K))
+		{
+			partition[kept.back()] |= partition[k];
+			continue;
+		}
+		bool dominated = false;
+		if (!partition[k])
+		{
+			for (int l: varKept[K[0]])
+			{
+				const std::vector<int>& L = cliques[l];
+				if (std::includes(L.begin(), L.end(), K.begin(), K.end()))
+				{
+					dominated = true;
+					break;
+				}
+			}
+		}
+		if (dominated) continue;
+		kept.push_back(k);
+		for (int j: K) varKept[j].push_back(k);
+	}
+	// build the compact table
+	boost::shared_ptr<CliqueTable> table(new CliqueTable());
+	table->cliqueBeg.push_back(0);
+	std::vector<int> newIdx(cliques.size(), -1);
+	for (int k: kept)
+	{
+		newIdx[k] = table->isPartition.size();
+		table->cliqueVars.insert(table->cliqueVars.end(), cliques[k].begin(), cliques[k].end());
+		table->cliqueBeg.push_back(table->cliqueVars.size());
+		table->isPartition.push_back(partition[k]);
+	}
+	table->varBeg.push_back(0);
+	for (unsigned int j = 0; j < n; j++)
+	{
+		for (int k: varKept[j]) table->varCliques.push_back(newIdx[k]);
+		table->varBeg.push_back(table->varCliques.size());
+	}
+	cliques.clear();
+	partition.clear();
+	numCreated++;
+	return new CliqueProp(d, this, table);
+}
+
+// auto registration
+
+class CLIQUE_FACTORY_RECORDER
+{
+public:
+	CLIQUE_FACTORY_RECORDER()
+	{
+		//std::cout << "Registering CliqueFactory...";
+		PropagatorFactories::getInstance().registerClass<CliqueFactory>("clique");
+		//std::cout << "done" << std::endl;
+	}
+};
+
+CLIQUE_FACTORY_RECORDER my_clique_factory_recorder;
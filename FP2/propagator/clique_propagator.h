@@ -0,0 +1,87 @@
+/**
+ * @file clique_propagator.h
+ * @brief Clique (conflict graph) propagator
+ *
+ * @author Domenico Salvagnin dominiqs@gmail.com
+ * 2008-2012
+ */
+
+#ifndef CLIQUE_PROPAGATOR_H
+#define CLIQUE_PROPAGATOR_H
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "propagator.h"
+
+/**
+ * Compact clique table, extracted from the set packing/partitioning rows
+ * Cliques are stored in CSR format, together with the column-wise
+ * var -> cliques incidence. It is read-only and shared among threads.
+ */
+
+struct CliqueTable
+{
+	unsigned int numCliques() const { return isPartition.size(); }
+	std::vector<int> cliqueBeg; //< cliqueBeg[k]..cliqueBeg[k+1] are the vars of clique k
+	std::vector<int> cliqueVars;
+	std::vector<char> isPartition; //< true if exactly one var of the clique must be 1
+	std::vector<int> varBeg; //< varBeg[j]..varBeg[j+1] are the cliques of var j
+	std::vector<int> varCliques;
+};
+
+typedef boost::shared_ptr<const CliqueTable> CliqueTablePtr;
+
+/**
+ * @brief Propagator for the conflict graph induced by a set of cliques
+ *
+ * Each clique k is a constraint sum_{j in K} x_j <= 1 (= 1 for partitioning rows).
+ * When a variable is fixed to 1, all its neighbours in the conflict graph
+ * (i.e. the other members of all the cliques it belongs to) are fixed to 0 in one pass,
+ * instead of going through one propagator per row.
+ */
+
+class CliqueProp : public Propagator
+{
+public:
+	CliqueProp(Domain* d, PropagatorFactory* fact, CliqueTablePtr _table);
+	Propagator* clone(Domain* d, PropagatorFactory* fact) const;
+	void createAdvisors(std::list<AdvisorI*>& advisors);
+	void propagate();
+	StatePtr getStateMgr();
+	// output
+	std::ostream& print(std::ostream& out) const;
+protected:
+	friend class CliqueAdvisor;
+	friend class CliquePropState;
+	// shared data
+	CliqueTablePtr table;
+	// state
+	std::vector<int> oneVar; //< variable fixed to 1 in each clique (-1 if none)
+	std::vector<int> numZeros; //< number of variables fixed to 0 in each clique
+	std::vector<int> pendingVars; //< variables fixed to 1 still to be processed
+	std::vector<int> pendingCliques; //< partitioning cliques with a single free variable left
+	// helpers
+	void fixedUp(int j);
+	void fixedDown(int j);
+};
+
+/**
+ * Factory: absorbs set packing/partitioning rows and builds a single CliqueProp
+ */
+
+class CliqueFactory : public PropagatorFactory
+{
+public:
+	PropagatorFactory* clone() const;
+	int getPriority() const;
+	const char* getName() const;
+	Propagator* analyze(Domain* d, dominiqs::Constraint* c);
+	bool absorb(Domain* d, dominiqs::Constraint* c);
+	Propagator* finalize(Domain* d);
+protected:
+	std::vector< std::vector<int> > cliques;
+	std::vector<char> partition;
+};
+
+#endif /* CLIQUE_PROPAGATOR_H */
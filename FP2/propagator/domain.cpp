@@ -10,13 +10,60 @@
 
 using namespace dominiqs;
 
-void Domain::pushVar(const std::string& name, char t, double l, double u)
+int VarNameTable::intern(const std::string& name)
 {
+	boost::unordered_map<std::string, int>::const_iterator itr = ids.find(name);
+	if (itr != ids.end()) return itr->second;
+	int id = names.size();
 	names.push_back(name);
+	ids[name] = id;
+	return id;
+}
+
+VarNameTablePtr VarNameTable::shared()
+{
+	static VarNameTablePtr theTable(new VarNameTable());
+	return theTable;
+}
+
+Domain::Domain() : names(new VarNameTable())
+{
+}
+
+void Domain::setNameTable(VarNameTablePtr table)
+{
+	DOMINIQS_ASSERT( table );
+	DOMINIQS_ASSERT( type.empty() );
+	names = table;
+}
+
+void Domain::pushVar(const std::string& name, char t, double l, double u)
+{
+	int j = type.size();
+	nameId.push_back(names->intern(name));
 	type.push_back(t);
-	lb.push_back(l);
-	ub.push_back(u);
-	fixed.push_back(equal(l, u));
+	if ((j & 63) == 0)
+	{
+		fixed.push_back(0);
+		value.push_back(0);
+	}
+	if (t == 'B')
+	{
+		DOMINIQS_ASSERT( greaterEqualThan(l, 0.0) && lessEqualThan(u, 1.0) );
+		slot.push_back(-1);
+		if (equal(l, u))
+		{
+			setBit(fixed, j);
+			if (equal(l, 1.0)) setBit(value, j);
+		}
+	}
+	else
+	{
+		slot.push_back(lb.size());
+		lb.push_back(l);
+		ub.push_back(u);
+		if (equal(l, u)) setBit(fixed, j);
+	}
 }
 
 StatePtr Domain::getStateMgr()
@@ -26,11 +73,13 @@ StatePtr Domain::getStateMgr()
 
 void Domain::clear()
 {
-	names.clear();
+	nameId.clear();
 	type.clear();
+	slot.clear();
+	fixed.clear();
+	value.clear();
 	lb.clear();
 	ub.clear();
-	fixed.clear();
 }
 
 DomainState* DomainState::clone() const
@@ -40,19 +89,20 @@ DomainState* DomainState::clone() const
 
 void DomainState::dump()
 {
+	fixed = domain->fixed;
+	value = domain->value;
 	lb = domain->lb;
 	ub = domain->ub;
-	fixed = domain->fixed;
 }
 
 void DomainState::restore()
 {
-	DOMINIQS_ASSERT( lb.size() == domain->names.size() );
-	DOMINIQS_ASSERT( ub.size() == domain->names.size() );
-	DOMINIQS_ASSERT( fixed.size() == domain->names.size() );
-	DOMINIQS_ASSERT( domain->fixed.size() == domain->names.size() );
+	DOMINIQS_ASSERT( fixed.size() == domain->fixed.size() );
+	DOMINIQS_ASSERT( value.size() == domain->value.size() );
+	DOMINIQS_ASSERT( lb.size() == domain->lb.size() );
+	DOMINIQS_ASSERT( ub.size() == domain->ub.size() );
+	domain->fixed = fixed;
+	domain->value = value;
 	domain->lb = lb;
 	domain->ub = ub;
-	domain->fixed = fixed;
 }
-
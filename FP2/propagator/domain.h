@@ -11,6 +11,9 @@
 
 #include <vector>
 #include <string>
+#include <stdint.h>
+#include <boost/unordered_map.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include <utils/floats.h>
 #include <utils/numarray.h>
@@ -25,13 +28,46 @@
 // forward declaration
 class DomainState;
 
+/**
+ * Interned, read-only (after init) table of variable names.
+ * Several domains (e.g. one per thread) can share the same table,
+ * so that each name is stored only once per process.
+ * Note that intern() is NOT thread-safe: tables must be filled at init time.
+ */
+
+class VarNameTable
+{
+public:
+	/**
+	 * Return the id of @param name, adding it to the table if needed
+	 */
+	int intern(const std::string& name);
+	inline const std::string& name(int id) const { return names[id]; }
+	inline unsigned int size() const { return names.size(); }
+	/**
+	 * Process-wide table, shared by all domains that ask for it
+	 */
+	static boost::shared_ptr<VarNameTable> shared();
+protected:
+	std::vector<std::string> names;
+	boost::unordered_map<std::string, int> ids;
+};
+
+typedef boost::shared_ptr<VarNameTable> VarNameTablePtr;
+
 /**
  * Stores the domains of a set of variables and their info
+ *
+ * Binary variables (the vast majority in our models) do not store their
+ * bounds explicitly: their state (free/fixed to 0/fixed to 1) is packed in
+ * two bits, the "fixed" bit (kept for every column) and the "value" bit.
+ * Only continuous and general integer columns get a slot in the lb/ub arrays.
  */
 
 class Domain
 {
 public:
+	Domain();
 	~Domain() { clear(); }
 	/**
 	 * Add a variable to the domain
@@ -42,54 +78,69 @@ public:
 	 */
 	virtual void pushVar(const std::string& name, char t, double l, double u);
 	virtual void clear();
+	/**
+	 * Use the name table @param table (must be called before any pushVar)
+	 */
+	void setNameTable(VarNameTablePtr table);
+	inline VarNameTablePtr getNameTable() const { return names; }
 	//@{
 	// getters
-	inline unsigned int size() const { return names.size(); }
-	inline std::string varName(int j) const { return names[j]; }
-	inline double varLb(int j) const { return lb[j]; }
-	inline double varUb(int j) const { return ub[j]; }
-	inline bool isVarFixed(int j) const { return fixed[j]; }
+	inline unsigned int size() const { return type.size(); }
+	inline const std::string& varName(int j) const { return names->name(nameId[j]); }
+	inline double varLb(int j) const
+	{
+		if (type[j] == 'B') return (testBit(fixed, j) && testBit(value, j)) ? 1.0 : 0.0;
+		return lb[slot[j]];
+	}
+	inline double varUb(int j) const
+	{
+		if (type[j] == 'B') return (testBit(fixed, j) && !testBit(value, j)) ? 0.0 : 1.0;
+		return ub[slot[j]];
+	}
+	inline bool isVarFixed(int j) const { return testBit(fixed, j); }
 	inline char varType(int j) const { return type[j]; }
 	//@}
 	//@{
 	// setters
 	inline void fixBinUp(int j)
 	{
-		DOMINIQS_ASSERT( dominiqs::equal(ub[j], 1.0) );
 		DOMINIQS_ASSERT( type[j] == 'B' );
-		lb[j] = 1.0;
-		fixed[j] = true;
+		DOMINIQS_ASSERT( !testBit(fixed, j) || testBit(value, j) );
+		setBit(value, j);
+		setBit(fixed, j);
 		if (emitFixedBinUp) emitFixedBinUp(j);
 	}
 	inline void fixBinDown(int j)
 	{
-		DOMINIQS_ASSERT( dominiqs::equal(lb[j], 0.0) );
 		DOMINIQS_ASSERT( type[j] == 'B' );
-		ub[j] = 0.0;
-		fixed[j] = true;
+		DOMINIQS_ASSERT( !testBit(fixed, j) || !testBit(value, j) );
+		resetBit(value, j);
+		setBit(fixed, j);
 		if (emitFixedBinDown) emitFixedBinDown(j);
 	}
 	inline void tightenLb(int j, double newValue)
 	{
 		DOMINIQS_ASSERT( type[j] != 'B' );
-		double oldValue = lb[j];
-		newValue = std::min(newValue, ub[j]);
+		int s = slot[j];
+		double oldValue = lb[s];
+		newValue = std::min(newValue, ub[s]);
 		if (dominiqs::greaterThan(newValue, oldValue))
 		{
-			lb[j] = newValue;
-			if (dominiqs::isNull(ub[j] - lb[j])) fixed[j] = true;
+			lb[s] = newValue;
+			if (dominiqs::isNull(ub[s] - lb[s])) setBit(fixed, j);
 			if (emitTightenedLb) emitTightenedLb(j, newValue, oldValue);
 		}
 	}
 	inline void tightenUb(int j, double newValue)
 	{
 		DOMINIQS_ASSERT( type[j] != 'B' );
-		double oldValue = ub[j];
-		newValue = std::max(newValue, lb[j]);
+		int s = slot[j];
+		double oldValue = ub[s];
+		newValue = std::max(newValue, lb[s]);
 		if (dominiqs::lessThan(newValue, oldValue))
 		{
-			ub[j] = newValue;
-			if (dominiqs::isNull(ub[j] - lb[j])) fixed[j] = true;
+			ub[s] = newValue;
+			if (dominiqs::isNull(ub[s] - lb[s])) setBit(fixed, j);
 			if (emitTightenedUb) emitTightenedUb(j, newValue, oldValue);
 		}
 	}
@@ -104,11 +155,22 @@ public:
 	StatePtr getStateMgr();
 protected:
 	friend class DomainState;
-	std::vector<std::string> names;
+	//@{
+	// bit helpers
+	static inline bool testBit(const dominiqs::numarray<uint64_t>& bits, int j) { return (bits[j >> 6] >> (j & 63)) & 1; }
+	static inline void setBit(dominiqs::numarray<uint64_t>& bits, int j) { bits[j >> 6] |= (uint64_t(1) << (j & 63)); }
+	static inline void resetBit(dominiqs::numarray<uint64_t>& bits, int j) { bits[j >> 6] &= ~(uint64_t(1) << (j & 63)); }
+	//@}
+	// static info
+	VarNameTablePtr names;
+	dominiqs::numarray<int> nameId;
+	dominiqs::numarray<char> type;
+	dominiqs::numarray<int> slot; //< index into lb/ub (non-binary columns only)
+	// dynamic info
+	dominiqs::numarray<uint64_t> fixed;
+	dominiqs::numarray<uint64_t> value; //< value of fixed binaries
 	dominiqs::numarray<double> lb;
 	dominiqs::numarray<double> ub;
-	dominiqs::numarray<bool> fixed;
-	dominiqs::numarray<char> type;
 };
 
 /**
@@ -124,9 +186,10 @@ public:
 	void restore();
 private:
 	Domain* domain;
+	dominiqs::numarray<uint64_t> fixed;
+	dominiqs::numarray<uint64_t> value;
 	dominiqs::numarray<double> lb;
 	dominiqs::numarray<double> ub;
-	dominiqs::numarray<bool> fixed;
 };
 
 #endif /* DOMAIN_H */
@@ -167,32 +167,28 @@ protected:
 	PropagatorState state;
 };
 
-LinearProp::LinearProp(Domain* d, PropagatorFactory* fact, Constraint* c) : Propagator(d, fact)
+LinearPropDataPtr LinearProp::extract(Domain* d, Constraint* c)
 {
-	DOMINIQS_ASSERT( domain );
+	DOMINIQS_ASSERT( d );
 	DOMINIQS_ASSERT( c );
-	name = c->name;
+	boost::shared_ptr<LinearPropData> data(new LinearPropData());
 	switch(c->sense)
 	{
 		case 'L':
-			lhs = -INFBOUND;
-			rhs = c->rhs;
+			data->lhs = -INFBOUND;
+			data->rhs = c->rhs;
 			break;
 		case 'E':
-			lhs = c->rhs;
-			rhs = c->rhs;
+			data->lhs = c->rhs;
+			data->rhs = c->rhs;
 			break;
 		case 'G':
-			lhs = c->rhs;
-			rhs = INFBOUND;
+			data->lhs = c->rhs;
+			data->rhs = INFBOUND;
 			break;
 		default:
 			throw std::runtime_error("Unknown constraint sense!");
 	}
-	minAct = 0.0;
-	maxAct = 0.0;
-	minActInfCnt = 0;
-	maxActInfCnt = 0;
 	unsigned int rowSize = c->row.size();
 	const int* idx = c->row.idx();
 	const double* coef = c->row.coef();
@@ -203,45 +199,77 @@ LinearProp::LinearProp(Domain* d, PropagatorFactory* fact, Constraint* c) : Prop
 		if (isNull(a)) continue;
 		if (a > 0.0)
 		{
-			if (domain->varType(j) == 'B')
+			if (d->varType(j) == 'B')
 			{
-				maxAct += a;
-				posBinIdx.push_back(j);
-				posBinCoef.push_back(a);
+				data->posBinIdx.push_back(j);
+				data->posBinCoef.push_back(a);
 			}
 			else
 			{
-				if (lessThan(domain->varUb(j), INFBOUND)) maxAct += (domain->varUb(j) * a);
-				else maxActInfCnt++;
-				if (greaterThan(domain->varLb(j), -INFBOUND)) minAct += (domain->varLb(j) * a);
-				else minActInfCnt++;
-				posIdx.push_back(j);
-				posCoef.push_back(a);
+				data->posIdx.push_back(j);
+				data->posCoef.push_back(a);
 			}
 		}
 		else // a < 0.0
 		{
-			if (domain->varType(j) == 'B')
+			if (d->varType(j) == 'B')
 			{
-				minAct += a;
-				negBinIdx.push_back(j);
-				negBinCoef.push_back(a);
+				data->negBinIdx.push_back(j);
+				data->negBinCoef.push_back(a);
 			}
 			else
 			{
-				if (lessThan(domain->varUb(j), INFBOUND)) minAct += (domain->varUb(j) * a);
-				else minActInfCnt++;
-				if (greaterThan(domain->varLb(j), -INFBOUND)) maxAct += (domain->varLb(j) * a);
-				else maxActInfCnt++;
-				negIdx.push_back(j);
-				negCoef.push_back(a);
+				data->negIdx.push_back(j);
+				data->negCoef.push_back(a);
 			}
 		}
 	}
+	return data;
+}
+
+LinearProp::LinearProp(Domain* d, PropagatorFactory* fact, Constraint* c)
+	: LinearProp(d, fact, c->name, extract(d, c))
+{
+}
+
+LinearProp::LinearProp(Domain* d, PropagatorFactory* fact, const std::string& _name, LinearPropDataPtr _data)
+	: Propagator(d, fact), data(_data), lhs(data->lhs), rhs(data->rhs),
+	posBinIdx(data->posBinIdx), posBinCoef(data->posBinCoef), negBinIdx(data->negBinIdx), negBinCoef(data->negBinCoef),
+	posIdx(data->posIdx), posCoef(data->posCoef), negIdx(data->negIdx), negCoef(data->negCoef)
+{
+	DOMINIQS_ASSERT( domain );
+	name = _name;
+	minAct = 0.0;
+	maxAct = 0.0;
+	minActInfCnt = 0;
+	maxActInfCnt = 0;
 	lastPosBin = posBinIdx.size();
 	lastNegBin = negBinIdx.size();
 	lastPos = posIdx.size();
 	lastNeg = negIdx.size();
+	unsigned int k;
+	int j;
+	double a;
+	for (k = 0; k < lastPosBin; k++) maxAct += posBinCoef[k];
+	for (k = 0; k < lastNegBin; k++) minAct += negBinCoef[k];
+	for (k = 0; k < lastPos; k++)
+	{
+		j = posIdx[k];
+		a = posCoef[k];
+		if (lessThan(domain->varUb(j), INFBOUND)) maxAct += (domain->varUb(j) * a);
+		else maxActInfCnt++;
+		if (greaterThan(domain->varLb(j), -INFBOUND)) minAct += (domain->varLb(j) * a);
+		else minActInfCnt++;
+	}
+	for (k = 0; k < lastNeg; k++)
+	{
+		j = negIdx[k];
+		a = negCoef[k];
+		if (lessThan(domain->varUb(j), INFBOUND)) minAct += (domain->varUb(j) * a);
+		else minActInfCnt++;
+		if (greaterThan(domain->varLb(j), -INFBOUND)) maxAct += (domain->varLb(j) * a);
+		else maxActInfCnt++;
+	}
 	updateState();
 	// std::cout << name << " " << lastPosBin << " " << lastNegBin << " / " << lastPos << " " << lastNeg << std::endl;
 	setPriority(LINEAR_DEFAULT_PRIORITY);
@@ -251,6 +279,11 @@ LinearProp::LinearProp(Domain* d, PropagatorFactory* fact, Constraint* c) : Prop
 	maxActDelta = -1.0;
 }
 
+Propagator* LinearProp::clone(Domain* d, PropagatorFactory* fact) const
+{
+	return new LinearProp(d, fact, name, data);
+}
+
 void LinearProp::createAdvisors(std::list<AdvisorI*>& advisors)
 {
 	unsigned int k;
@@ -618,33 +651,46 @@ protected:
 	PropagatorState state;
 };
 
-CardinalityProp::CardinalityProp(Domain* d, PropagatorFactory* fact, Constraint* c) : Propagator(d, fact)
+CardinalityPropDataPtr CardinalityProp::extract(Domain* d, Constraint* c)
 {
-	DOMINIQS_ASSERT( domain );
+	DOMINIQS_ASSERT( d );
 	DOMINIQS_ASSERT( c );
-	name = c->name;
+	boost::shared_ptr<CardinalityPropData> data(new CardinalityPropData());
 	// assuming data is correct
-	idx.resize(c->row.size());
-	std::copy(c->row.idx(), c->row.idx() + c->row.size(), idx.begin());
+	data->idx.resize(c->row.size());
+	std::copy(c->row.idx(), c->row.idx() + c->row.size(), data->idx.begin());
 	switch(c->sense)
 	{
 		case 'L':
-			lhs = 0;
-			rhs = (int)floorEps(c->rhs);
+			data->lhs = 0;
+			data->rhs = (int)floorEps(c->rhs);
 			break;
 		case 'E':
-			lhs = (int)c->rhs;
-			rhs = (int)c->rhs;
+			data->lhs = (int)c->rhs;
+			data->rhs = (int)c->rhs;
 			break;
 		case 'G':
-			lhs = (int)ceilEps(c->rhs);
-			rhs = idx.size();
+			data->lhs = (int)ceilEps(c->rhs);
+			data->rhs = data->idx.size();
 			break;
 		default:
 			throw std::runtime_error("Unknown constraint sense!");
 	}
+	return data;
+}
+
+CardinalityProp::CardinalityProp(Domain* d, PropagatorFactory* fact, Constraint* c)
+	: CardinalityProp(d, fact, c->name, extract(d, c))
+{
+}
+
+CardinalityProp::CardinalityProp(Domain* d, PropagatorFactory* fact, const std::string& _name, CardinalityPropDataPtr _data)
+	: Propagator(d, fact), data(_data), lhs(data->lhs), rhs(data->rhs), idx(data->idx)
+{
+	DOMINIQS_ASSERT( domain );
+	name = _name;
 	minAct = 0;
-	int k = (int)c->row.size();
+	int k = (int)idx.size();
 	maxAct = k;
 	for (int i = 0; i < k; i++)
 	{
@@ -659,6 +705,11 @@ CardinalityProp::CardinalityProp(Domain* d, PropagatorFactory* fact, Constraint*
 	setPriority(CARDINALITY_DEFAULT_PRIORITY);
 }
 
+Propagator* CardinalityProp::clone(Domain* d, PropagatorFactory* fact) const
+{
+	return new CardinalityProp(d, fact, name, data);
+}
+
 void CardinalityProp::createAdvisors(std::list<AdvisorI*>& advisors)
 {
 	for (int i: idx) advisors.push_back(new CardinalityAdvisor(this, i));
@@ -825,61 +876,85 @@ protected:
 	double a;
 };
 
-KnapsackProp::KnapsackProp(Domain* d, PropagatorFactory* fact, Constraint* c) : Propagator(d, fact)
+KnapsackPropDataPtr KnapsackProp::extract(Domain* d, Constraint* c)
 {
-	DOMINIQS_ASSERT( domain );
+	DOMINIQS_ASSERT( d );
 	DOMINIQS_ASSERT( c );
-	name = c->name;
+	boost::shared_ptr<KnapsackPropData> data(new KnapsackPropData());
 	// assuming data is correct
 	switch(c->sense)
 	{
 		case 'L':
-			lhs = -INFBOUND;
-			rhs = c->rhs;
+			data->lhs = -INFBOUND;
+			data->rhs = c->rhs;
 			break;
 		case 'E':
-			lhs = c->rhs;
-			rhs = c->rhs;
+			data->lhs = c->rhs;
+			data->rhs = c->rhs;
 			break;
 		case 'G':
-			lhs = c->rhs;
-			rhs = INFBOUND;
+			data->lhs = c->rhs;
+			data->rhs = INFBOUND;
 			break;
 		default:
 			throw std::runtime_error("Unknown constraint sense!");
 	}
-	minAct = 0.0;
-	maxAct = 0.0;
 	unsigned int rowSize = c->row.size();
 	const int* idx = c->row.idx();
-    const double* coef = c->row.coef();
+	const double* coef = c->row.coef();
 	for (unsigned int k = 0; k < rowSize; k++)
 	{
 		int j = idx[k];
 		double a = coef[k];
 		if (isNull(a)) continue;
 		DOMINIQS_ASSERT( a > 0.0 );
-		if (domain->varType(j) == 'B')
+		if (d->varType(j) == 'B')
 		{
-			maxAct += a;
-			posBinIdx.push_back(j);
-			posBinCoef.push_back(a);
+			data->posBinIdx.push_back(j);
+			data->posBinCoef.push_back(a);
 		}
 		else
 		{
-			minAct += a * domain->varLb(j);
-			maxAct += a * domain->varUb(j);
-			posIdx.push_back(j);
-			posCoef.push_back(a);
+			data->posIdx.push_back(j);
+			data->posCoef.push_back(a);
 		}
 	}
+	return data;
+}
+
+KnapsackProp::KnapsackProp(Domain* d, PropagatorFactory* fact, Constraint* c)
+	: KnapsackProp(d, fact, c->name, extract(d, c))
+{
+}
+
+KnapsackProp::KnapsackProp(Domain* d, PropagatorFactory* fact, const std::string& _name, KnapsackPropDataPtr _data)
+	: Propagator(d, fact), data(_data), lhs(data->lhs), rhs(data->rhs),
+	posBinIdx(data->posBinIdx), posBinCoef(data->posBinCoef), posIdx(data->posIdx), posCoef(data->posCoef)
+{
+	DOMINIQS_ASSERT( domain );
+	name = _name;
+	minAct = 0.0;
+	maxAct = 0.0;
 	lastPosBin = posBinIdx.size();
 	lastPos = posIdx.size();
+	unsigned int k;
+	for (k = 0; k < lastPosBin; k++) maxAct += posBinCoef[k];
+	for (k = 0; k < lastPos; k++)
+	{
+		int j = posIdx[k];
+		minAct += posCoef[k] * domain->varLb(j);
+		maxAct += posCoef[k] * domain->varUb(j);
+	}
 	maxActDelta = -1.0;
 	updateState();
 	setPriority(KNAPSACK_DEFAULT_PRIORITY);
 }
 
+Propagator* KnapsackProp::clone(Domain* d, PropagatorFactory* fact) const
+{
+	return new KnapsackProp(d, fact, name, data);
+}
+
 void KnapsackProp::createAdvisors(std::list<AdvisorI*>& advisors)
 {
 	unsigned int k;
@@ -10,9 +10,31 @@
 #define LINEAR_PROPAGATOR_H
 
 #include <vector>
+#include <boost/shared_ptr.hpp>
 
 #include "propagator.h"
 
+/**
+ * Read-only data of a linear propagator
+ * It is shared among all the copies of the same propagator (one per thread)
+ */
+
+struct LinearPropData
+{
+	double lhs;
+	double rhs;
+	std::vector<int> posBinIdx;
+	std::vector<double> posBinCoef;
+	std::vector<int> negBinIdx;
+	std::vector<double> negBinCoef;
+	std::vector<int> posIdx;
+	std::vector<double> posCoef;
+	std::vector<int> negIdx;
+	std::vector<double> negCoef;
+};
+
+typedef boost::shared_ptr<const LinearPropData> LinearPropDataPtr;
+
 /**
  * @brief Propagator for the linear (ranged) constraint lhs <= a^T x <= rhs
  *
@@ -25,6 +47,8 @@ class LinearProp : public Propagator
 {
 public:
 	LinearProp(Domain* d, PropagatorFactory* fact, dominiqs::Constraint* c);
+	LinearProp(Domain* d, PropagatorFactory* fact, const std::string& _name, LinearPropDataPtr _data);
+	Propagator* clone(Domain* d, PropagatorFactory* fact) const;
 	void createAdvisors(std::list<AdvisorI*>& advisors);
 	void propagate();
 	StatePtr getStateMgr();
@@ -32,23 +56,26 @@ protected:
 	friend class PositiveLinearAdvisor;
 	friend class NegativeLinearAdvisor;
 	friend class LinearPropState;
-	double lhs;
-	double rhs;
+	// shared data
+	LinearPropDataPtr data;
+	const double& lhs;
+	const double& rhs;
+	const std::vector<int>& posBinIdx;
+	const std::vector<double>& posBinCoef;
+	const std::vector<int>& negBinIdx;
+	const std::vector<double>& negBinCoef;
+	const std::vector<int>& posIdx;
+	const std::vector<double>& posCoef;
+	const std::vector<int>& negIdx;
+	const std::vector<double>& negCoef;
+	// state
 	double minAct;
 	double maxAct;
 	int minActInfCnt;
 	int maxActInfCnt;
-	std::vector<int> posBinIdx;
-	std::vector<double> posBinCoef;
 	unsigned int lastPosBin;
-	std::vector<int> negBinIdx;
-	std::vector<double> negBinCoef;
 	unsigned int lastNegBin;
-	std::vector<int> posIdx;
-	std::vector<double> posCoef;
 	unsigned int lastPos;
-	std::vector<int> negIdx;
-	std::vector<double> negCoef;
 	unsigned int lastNeg;
 	// optimizations
 	int minActInfIdx;
@@ -58,6 +85,7 @@ protected:
 	double maxActDelta;
 	// helpers
 	void updateState();
+	static LinearPropDataPtr extract(Domain* d, dominiqs::Constraint* c);
 };
 
 class LinearFactory : public PropagatorFactory
@@ -69,6 +97,19 @@ public:
 	Propagator* analyze(Domain* d, dominiqs::Constraint* c);
 };
 
+/**
+ * Read-only data of a cardinality propagator (shared among threads)
+ */
+
+struct CardinalityPropData
+{
+	int lhs;
+	int rhs;
+	std::vector<int> idx;
+};
+
+typedef boost::shared_ptr<const CardinalityPropData> CardinalityPropDataPtr;
+
 /**
  * @brief Propagator for the cardinality constraint
  * lhs <= e x <= rhs, all x_j binary
@@ -80,6 +121,8 @@ class CardinalityProp : public Propagator
 {
 public:
 	CardinalityProp(Domain* d, PropagatorFactory* fact, dominiqs::Constraint* c);
+	CardinalityProp(Domain* d, PropagatorFactory* fact, const std::string& _name, CardinalityPropDataPtr _data);
+	Propagator* clone(Domain* d, PropagatorFactory* fact) const;
 	void createAdvisors(std::list<AdvisorI*>& advisors);
 	void propagate();
 	StatePtr getStateMgr();
@@ -88,13 +131,17 @@ public:
 protected:
 	friend class CardinalityAdvisor;
 	friend class CardinalityPropState;
-	int lhs;
-	int rhs;
-	std::vector<int> idx;
+	// shared data
+	CardinalityPropDataPtr data;
+	const int& lhs;
+	const int& rhs;
+	const std::vector<int>& idx;
+	// state
 	int minAct;
 	int maxAct;
 	// helpers
 	void updateState();
+	static CardinalityPropDataPtr extract(Domain* d, dominiqs::Constraint* c);
 };
 
 class CardinalityFactory : public PropagatorFactory
@@ -106,6 +153,22 @@ public:
 	Propagator* analyze(Domain* d, dominiqs::Constraint* c);
 };
 
+/**
+ * Read-only data of a knapsack propagator (shared among threads)
+ */
+
+struct KnapsackPropData
+{
+	double lhs;
+	double rhs;
+	std::vector<int> posBinIdx;
+	std::vector<double> posBinCoef;
+	std::vector<int> posIdx;
+	std::vector<double> posCoef;
+};
+
+typedef boost::shared_ptr<const KnapsackPropData> KnapsackPropDataPtr;
+
 /**
  * @brief This is a propagator for the knapsack constraint:
  * lhs <= a^T x <= rhs, a,lhs,rhs > 0, 0 <= l <= x <= u
@@ -115,6 +178,8 @@ class KnapsackProp : public Propagator
 {
 public:
 	KnapsackProp(Domain* d, PropagatorFactory* fact, dominiqs::Constraint* c);
+	KnapsackProp(Domain* d, PropagatorFactory* fact, const std::string& _name, KnapsackPropDataPtr _data);
+	Propagator* clone(Domain* d, PropagatorFactory* fact) const;
 	void createAdvisors(std::list<AdvisorI*>& advisors);
 	void propagate();
 	StatePtr getStateMgr();
@@ -123,20 +188,24 @@ public:
 protected:
 	friend class KnapsackAdvisor;
 	friend class KnapsackPropState;
-	double lhs;
-	double rhs;
+	// shared data
+	KnapsackPropDataPtr data;
+	const double& lhs;
+	const double& rhs;
+	const std::vector<int>& posBinIdx;
+	const std::vector<double>& posBinCoef;
+	const std::vector<int>& posIdx;
+	const std::vector<double>& posCoef;
+	// state
 	double minAct;
 	double maxAct;
-	std::vector<int> posBinIdx;
-	std::vector<double> posBinCoef;
 	unsigned int lastPosBin;
-	std::vector<int> posIdx;
-	std::vector<double> posCoef;
 	unsigned int lastPos;
 	// optimizations
 	double maxActDelta;
 	// helpers
 	void updateState();
+	static KnapsackPropDataPtr extract(Domain* d, dominiqs::Constraint* c);
 };
 
 class KnapsackFactory : public PropagatorFactory
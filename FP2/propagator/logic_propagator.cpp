@@ -131,6 +131,11 @@ ImpliesProp::ImpliesProp(Domain* d, PropagatorFactory* fact, const std::string&
 	state = ImpliesState[antecedent][consequent];
 }
 
+Propagator* ImpliesProp::clone(Domain* d, PropagatorFactory* fact) const
+{
+	return new ImpliesProp(d, fact, name, anteIdx, consIdx);
+}
+
 void ImpliesProp::createAdvisors(std::list<AdvisorI*>& advisors)
 {
 	advisors.push_back(new ImpliesAntecedentAdvisor(this, anteIdx));
@@ -222,6 +227,11 @@ EquivProp::EquivProp(Domain* d, PropagatorFactory* fact, const std::string& _nam
 	updateState();
 }
 
+Propagator* EquivProp::clone(Domain* d, PropagatorFactory* fact) const
+{
+	return new EquivProp(d, fact, name, firstIdx, secondIdx);
+}
+
 void EquivProp::createAdvisors(std::list<AdvisorI*>& advisors)
 {
 	advisors.push_back(new EquivAdvisor(this, firstIdx));
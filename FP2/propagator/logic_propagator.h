@@ -20,6 +20,7 @@ class ImpliesProp : public Propagator
 {
 public:
 	ImpliesProp(Domain* d, PropagatorFactory* fact, const std::string& _name, int xIdx, int yIdx);
+	Propagator* clone(Domain* d, PropagatorFactory* fact) const;
 	void createAdvisors(std::list<AdvisorI*>& advisors);
 	void propagate();
 	StatePtr getStateMgr();
@@ -43,6 +44,7 @@ class EquivProp : public Propagator
 {
 public:
 	EquivProp(Domain* d, PropagatorFactory* fact, const std::string& _name, int xIdx, int yIdx);
+	Propagator* clone(Domain* d, PropagatorFactory* fact) const;
 	void createAdvisors(std::list<AdvisorI*>& advisors);
 	void propagate();
 	StatePtr getStateMgr();
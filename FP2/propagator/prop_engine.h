@@ -55,6 +55,7 @@ public:
 	virtual bool propagate(int var, double value);
 	virtual bool propagate(const std::vector<int>& vars, const std::vector<double>& values);
 	const std::vector<int>& getLastFixed() const { return lastFixed; }
+	const std::vector<Propagator*>& getPropagators() const { return propagators; }
 	bool failed() const { return hasFailed; }
 	// state handler
 	StatePtr getStateMgr();
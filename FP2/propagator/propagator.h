@@ -53,6 +53,13 @@ public:
 	Propagator(Domain* d, PropagatorFactory* fact = 0)
 		: domain(d), factory(fact), id(-1), priority(0), dirty(true), state(CSTATE_UNKNOWN) {}
 	virtual ~Propagator() {}
+	/**
+	 * Create a copy of this propagator living on domain @param d
+	 * The copy shares with this propagator all the read-only data (row structure),
+	 * while the mutable state (activities, etc...) is recomputed from @param d
+	 * @return the new propagator, or 0 if this propagator cannot be shared
+	 */
+	virtual Propagator* clone(Domain* d, PropagatorFactory* fact) const { return 0; }
 	/**
 	 * Create the advisors needed to effectively propagate and return them
 	 */
@@ -68,6 +75,7 @@ public:
 	inline int getPriority() const { return priority; }
 	inline void setPriority(int p) { priority = p; }
 	inline Domain* getDomain() const { return domain; }
+	inline PropagatorFactory* getFactory() const { return factory; }
 	inline void setPending() { dirty = true; }
 	inline bool pending() const { return dirty; }
 	inline PropagatorState getState() const { return state; }
@@ -111,6 +119,14 @@ public:
 	virtual int getPriority() const =0;
 	virtual const char* getName() const =0;
 	virtual Propagator* analyze(Domain* d, dominiqs::Constraint* c) =0;
+	/**
+	 * Global factories collect structure from many constraints into a single propagator:
+	 * absorb() returns true if constraint @param c has been taken over by the factory
+	 * (and hence no other propagator must be created for it), while finalize()
+	 * creates the resulting propagator (if any) once all constraints have been seen
+	 */
+	virtual bool absorb(Domain* d, dominiqs::Constraint* c) { return false; }
+	virtual Propagator* finalize(Domain* d) { return 0; }
 	// stats
 	void reset();
 	inline int created() const { return numCreated; }
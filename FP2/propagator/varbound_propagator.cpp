@@ -100,6 +100,11 @@ VarLowerBoundProp::VarLowerBoundProp(Domain* d, PropagatorFactory* fact, const s
 	}
 }
 
+Propagator* VarLowerBoundProp::clone(Domain* d, PropagatorFactory* fact) const
+{
+	return new VarLowerBoundProp(d, fact, name, xIdx, yIdx, yCoef, lb);
+}
+
 void VarLowerBoundProp::createAdvisors(std::list<AdvisorI*>& advisors)
 {
 	advisors.push_back(new VarLowerBoundPropAdvisor(this, yIdx));
@@ -214,6 +219,11 @@ VarUpperBoundProp::VarUpperBoundProp(Domain* d, PropagatorFactory* fact, const s
 	}
 }
 
+Propagator* VarUpperBoundProp::clone(Domain* d, PropagatorFactory* fact) const
+{
+	return new VarUpperBoundProp(d, fact, name, xIdx, yIdx, yCoef, ub);
+}
+
 void VarUpperBoundProp::createAdvisors(std::list<AdvisorI*>& advisors)
 {
 	advisors.push_back(new VarUpperBoundPropAdvisor(this, yIdx));
@@ -22,6 +22,7 @@ class VarLowerBoundProp : public Propagator
 {
 public:
 	VarLowerBoundProp(Domain* d, PropagatorFactory* fact, const std::string& _name, int _xIdx, int _yIdx, double _yCoef, double _lb);
+	Propagator* clone(Domain* d, PropagatorFactory* fact) const;
 	void createAdvisors(std::list<AdvisorI*>& advisors);
 	void propagate();
 	StatePtr getStateMgr();
@@ -49,6 +50,7 @@ class VarUpperBoundProp : public Propagator
 {
 public:
 	VarUpperBoundProp(Domain* d, PropagatorFactory* fact, const std::string& _name, int _xIdx, int _yIdx, double _yCoef, double _ub);
+	Propagator* clone(Domain* d, PropagatorFactory* fact) const;
 	void createAdvisors(std::list<AdvisorI*>& advisors);
 	void propagate();
 	StatePtr getStateMgr();
@@ -0,0 +1,254 @@
+/*******************************************************************************
+ * benchmark_l1_distance.cpp: benchmark of the L1 distance kernels.
+ *
+ * Author: Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ *
+ * (c) Copyright 2015-2019
+ *     Industrial and Systems Engineering, Georgia Institute of Technology
+ *     All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by andrade
+ *  Last update: Oct 18, 2026 by andrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+
+#include "plain_ragged_matrix.hpp"
+#include "distance_kernels.hpp"
+#include "mtrand.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Eigen and Boost in some platforms have a lot of problems with some
+// compile flags. So, we just deactivate these flags here.
+#include "pragma_diagnostic_ignored_header.hpp"
+#include "Eigen/Dense"
+#include "Eigen/SparseCore"
+#include <boost/timer/timer.hpp>
+#include "pragma_diagnostic_ignored_footer.hpp"
+
+using namespace std;
+using namespace ce_andrade;
+
+typedef Eigen::SparseMatrix<double, Eigen::RowMajor> SparseMatrix;
+typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> DenseMatrix;
+
+/// Number of rows used to check the kernels against each other.
+const long CHECK_ROWS = 1000;
+
+//---------------------------[ Distance sink ]--------------------------------//
+
+/// A full distance matrix for N = 50k takes 10 GB. So, to time the kernels
+/// on large instances, the distances are just thrown on one slot per thread
+/// (one cache line apart, to avoid false sharing).
+class DistanceSink {
+    public:
+        DistanceSink(): slots(8 * maxThreads(), 0.0) {}
+
+        double& operator()(const long, const long) {
+            #ifdef _OPENMP
+            return slots[8 * omp_get_thread_num()];
+            #else
+            return slots[0];
+            #endif
+        }
+
+    protected:
+        vector<double> slots;
+
+        static int maxThreads() {
+            #ifdef _OPENMP
+            return omp_get_max_threads();
+            #else
+            return 1;
+            #endif
+        }
+};
+
+//--------------------------[ Reference kernel ]------------------------------//
+
+/// The previous Clusterator::computeL1Distance(): a dense Eigen row against
+/// all the next ones, with a parallel region per row.
+template <typename DistanceMatrix>
+void referenceL1Distance(const DenseMatrix &matrix, DistanceMatrix &dist) {
+    const long N = matrix.rows();
+    for(long i = 0; i < N - 1; ++i) {
+        const auto &row = matrix.row(i);
+
+        #ifdef _OPENMP
+        #pragma omp parallel for shared(row)
+        #endif
+        for(long j = i + 1; j < N; ++j)
+            dist(j, i) = (row - matrix.row(j)).lpNorm<1>();
+    }
+}
+
+/// Pairwise merge of the sparse rows (l1RowDistance()), row by row.
+template <typename DistanceMatrix>
+void mergeL1Distance(const SparseMatrix &matrix, DistanceMatrix &dist) {
+    const long N = matrix.rows();
+
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 16)
+    #endif
+    for(long i = 1; i < N; ++i)
+        for(long j = 0; j < i; ++j)
+            dist(i, j) = l1RowDistance(matrix, i, j);
+}
+
+//--------------------------------[ Helpers ]---------------------------------//
+
+/// Build a random num_rows x num_cols sparse matrix with integer
+/// coefficients in [-5, 5] (no zeros) and the given density.
+SparseMatrix randomMatrix(const long num_rows, const long num_cols,
+                          const double density, MTRand &rng) {
+    typedef Eigen::Triplet<double> Entry;
+    vector<Entry> entries;
+    entries.reserve((size_t)(density * num_rows * num_cols * 1.1) + 1);
+
+    for(long i = 0; i < num_rows; ++i)
+        for(long j = 0; j < num_cols; ++j)
+            if(rng.randExc() < density)
+                entries.emplace_back(i, j, (double)rng.randInt(1, 5) *
+                                           (rng.randInt(1) == 0? -1.0 : 1.0));
+
+    SparseMatrix matrix(num_rows, num_cols);
+    matrix.setFromTriplets(entries.begin(), entries.end());
+    return matrix;
+}
+
+/// Return the largest difference between two distance matrices.
+double maxDifference(PlainRaggedMatrix<double, long> &a,
+                     PlainRaggedMatrix<double, long> &b) {
+    double diff = 0.0;
+    for(long i = 1; i < a.getSize(); ++i)
+        for(long j = 0; j < i; ++j)
+            diff = max(diff, fabs(a(i, j) - b(i, j)));
+    return diff;
+}
+
+/// Return the elapsed wall time of the timer, in seconds.
+double seconds(const boost::timer::cpu_timer &timer) {
+    return timer.elapsed().wall / 1e9;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    if(argc > 1 && (string(argv[1]) == "-h" || string(argv[1]) == "--help")) {
+        cerr << "usage: " << argv[0]
+             << " [<num-columns> [<density> [<num-rows> ...]]]"
+             << "\n(default: 1000 columns, density 0.01, and"
+             << " 5000, 20000, and 50000 rows)"
+             << endl;
+        return 64;  // BSD usage error code.
+    }
+
+    const long num_cols = (argc > 1? atol(argv[1]) : 1000);
+    const double density = (argc > 2? atof(argv[2]) : 0.01);
+
+    vector<long> sizes;
+    for(int i = 3; i < argc; ++i)
+        sizes.push_back(atol(argv[i]));
+    if(sizes.empty())
+        sizes = {5000, 20000, 50000};
+
+    MTRand rng(2707);
+
+    cout << "> Columns: " << num_cols
+         << "\n> Density: " << density
+         #ifdef _OPENMP
+         << "\n> Threads: " << omp_get_max_threads()
+         #endif
+         << endl;
+
+    try {
+        // First, check that the kernels agree.
+        {
+            const SparseMatrix sparse(randomMatrix(CHECK_ROWS, num_cols, density, rng));
+            const DenseMatrix dense(sparse);
+
+            PlainRaggedMatrix<double, long> ref_dist(CHECK_ROWS);
+            PlainRaggedMatrix<double, long> dense_dist(CHECK_ROWS);
+            PlainRaggedMatrix<double, long> merge_dist(CHECK_ROWS);
+            PlainRaggedMatrix<double, long> sparse_dist(CHECK_ROWS);
+
+            referenceL1Distance(dense, ref_dist);
+            l1DistanceDense(dense.data(), dense.rows(), dense.cols(), dense_dist);
+            mergeL1Distance(sparse, merge_dist);
+            l1DistanceSparse(sparse, sparse_dist);
+
+            const double diff = max(maxDifference(ref_dist, dense_dist),
+                                    max(maxDifference(ref_dist, merge_dist),
+                                        maxDifference(ref_dist, sparse_dist)));
+
+            cout << "> Max. difference to reference (N = " << CHECK_ROWS
+                 << "): " << diff << endl;
+
+            if(diff > 1e-9)
+                throw runtime_error("The kernels disagree.");
+        }
+
+        cout << "\n" << setw(8) << "N"
+             << setw(14) << "reference(s)"
+             << setw(14) << "dense(s)"
+             << setw(14) << "merge(s)"
+             << setw(14) << "sparse(s)"
+             << endl;
+
+        for(const auto N : sizes) {
+            const SparseMatrix sparse(randomMatrix(N, num_cols, density, rng));
+            const DenseMatrix dense(sparse);
+            DistanceSink sink;
+            boost::timer::cpu_timer timer;
+
+            cout << setw(8) << N << flush;
+
+            timer.start();
+            referenceL1Distance(dense, sink);
+            cout << setw(14) << fixed << setprecision(3) << seconds(timer) << flush;
+
+            timer.start();
+            l1DistanceDense(dense.data(), dense.rows(), dense.cols(), sink);
+            cout << setw(14) << seconds(timer) << flush;
+
+            timer.start();
+            mergeL1Distance(sparse, sink);
+            cout << setw(14) << seconds(timer) << flush;
+
+            timer.start();
+            l1DistanceSparse(sparse, sink);
+            cout << setw(14) << seconds(timer) << endl;
+        }
+    }
+    catch(std::exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return -1;
+    }
+
+    return 0;
+}
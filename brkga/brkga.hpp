@@ -198,6 +198,16 @@ public:
      */
     void exchangeElite(unsigned M);
 
+    /**
+     * Set gene blocks for the crossover. Instead of each allele, each block
+     * is inherited as a whole from the elite parent with probability rhoe,
+     * or from the non-elite parent otherwise. Genes not in any block are
+     * inherited one by one, as in the uniform crossover.
+     * \param blocks disjoint sets of genes. If empty, the uniform crossover
+     *        is used.
+     */
+    void setCrossoverBlocks(const std::vector< std::vector<unsigned> >& blocks);
+
     /**
      * Returns the current population
      */
@@ -253,6 +263,7 @@ private:
     bool initialized;                       ///< Indicate if the algorithm was proper initialized
     bool reset_phase;                       ///< Indicate if the algorithm have been reset
     bool maximize;                          ///< Indicate if is maximization or minimization
+    std::vector< std::vector<unsigned> > crossover_blocks;  ///< Gene blocks for the crossover (empty for uniform)
     //@}
 
     /** Local methods */
@@ -290,7 +301,8 @@ BRKGA<Decoder, RNG>::BRKGA(unsigned _n, unsigned _p, double _pe, double _pm, dou
         right_lb(_right_lb), right_ub(_right_ub), previous(K, 0),
         current(K, 0), initialPopulation(false), initialized(false),
         reset_phase(false),
-        maximize(sense == Sense::MAXIMIZE)
+        maximize(sense == Sense::MAXIMIZE),
+        crossover_blocks()
 {
     // Error check:
     using std::range_error;
@@ -399,6 +411,31 @@ void BRKGA<Decoder, RNG>::exchangeElite(unsigned M) {
     for(int i = 0; i < int(K); ++i) { current[i]->sortFitness(maximize); }
 }
 
+template<class Decoder, class RNG>
+void BRKGA<Decoder, RNG>::setCrossoverBlocks(const std::vector< std::vector<unsigned> >& blocks) {
+    crossover_blocks.clear();
+    if(blocks.empty())
+        return;
+
+    std::vector<bool> covered(n, false);
+    for(const auto &block : blocks) {
+        if(block.empty())
+            continue;
+
+        for(const auto gene : block) {
+            if(gene >= n) { throw std::range_error("Crossover block gene out of range."); }
+            if(covered[gene]) { throw std::range_error("Crossover blocks are not disjoint."); }
+            covered[gene] = true;
+        }
+        crossover_blocks.push_back(block);
+    }
+
+    // The remaining genes are blocks by themselves.
+    for(unsigned j = 0; j < n; ++j)
+        if(!covered[j])
+            crossover_blocks.push_back(std::vector<unsigned>(1, j));
+}
+
 template<class Decoder, class RNG>
 void BRKGA<Decoder, RNG>::setInitialPopulation(const std::vector< Chromosome >& chromosomes) {
 //    if(initialPopulation) {
@@ -527,13 +564,25 @@ inline void BRKGA<Decoder, RNG>::evolution(Population& curr, Population& next) {
         const unsigned noneliteParent = pe + (refRNG.randInt(p - pe - 1));
 
         // Mate:
-        for(j = 0; j < n; ++j) {
-            const unsigned sourceParent = ((refRNG.rand() < rhoe) ? eliteParent : noneliteParent);
+        if(crossover_blocks.empty()) {
+            for(j = 0; j < n; ++j) {
+                const unsigned sourceParent = ((refRNG.rand() < rhoe) ? eliteParent : noneliteParent);
 
-            next(i, j) = curr(curr.fitness[sourceParent].second, j);
+                next(i, j) = curr(curr.fitness[sourceParent].second, j);
 
-            //next(i, j) = (refRNG.rand() < rhoe) ? curr(curr.fitness[eliteParent].second, j) :
-            //                                    curr(curr.fitness[noneliteParent].second, j);
+                //next(i, j) = (refRNG.rand() < rhoe) ? curr(curr.fitness[eliteParent].second, j) :
+                //                                    curr(curr.fitness[noneliteParent].second, j);
+            }
+        }
+        else {
+            // Each block comes entirely from one parent.
+            for(const auto &block : crossover_blocks) {
+                const unsigned sourceParent = ((refRNG.rand() < rhoe) ? eliteParent : noneliteParent);
+                const unsigned source = curr.fitness[sourceParent].second;
+
+                for(const auto gene : block)
+                    next(i, gene) = curr(source, gene);
+            }
         }
 
         typedef Chromosome::ChromosomeType LocalChrType;
@@ -10,7 +10,7 @@
  *     All Rights Reserved.
  *
  *  Created on : Jan 30, 2014 by andrade
- *  Last update: Jun 02, 2015 by andrade
+ *  Last update: Oct 18, 2026 by andrade
  *
  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
@@ -30,6 +30,8 @@
 
 #include <vector>
 #include <limits>
+#include <utility>
+#include <stdint.h>
 
 namespace BRKGA_ALG {
 /**
@@ -75,7 +77,8 @@ class Chromosome: public std::vector<Allele> {
             fractionality(std::numeric_limits<double>::max()),
             num_non_integral_vars(std::numeric_limits<unsigned>::max()),
             num_iterations(std::numeric_limits<unsigned>::max()),
-            rounded()
+            rounded(),
+            rounding_id(0)
             {}
 
         /**
@@ -90,7 +93,8 @@ class Chromosome: public std::vector<Allele> {
             fractionality(std::numeric_limits<double>::max()),
             num_non_integral_vars(std::numeric_limits<unsigned>::max()),
             num_iterations(std::numeric_limits<unsigned>::max()),
-            rounded(_size, 0)
+            rounded(_size, 0),
+            rounding_id(0)
             {}
         //@}
 
@@ -119,6 +123,7 @@ class Chromosome: public std::vector<Allele> {
         void swap(Chromosome& __x) noexcept {
             std::vector<Allele>::swap(__x);
             rounded.swap(__x.rounded);
+            std::swap(rounding_id, __x.rounding_id);
         }
         //@}
 
@@ -129,6 +134,10 @@ class Chromosome: public std::vector<Allele> {
         unsigned num_non_integral_vars;
         unsigned num_iterations;
         std::vector<int> rounded;
+
+        /// Identifies the decoding that produced "rounded". It is set by
+        /// Population::setFitness() and kept by copies. Zero if unknown.
+        uint64_t rounding_id;
 };
 } // end namespace BRKGA_ALG
 
@@ -8,7 +8,7 @@
  *     All Rights Reserved.
  *
  *  Created on : Jan 30, 2014 by andrade
- *  Last update: Feb 11, 2015 by andrade
+ *  Last update: Oct 18, 2026 by andrade
 
  *  This software is based on the work of Rodrigo Franco Toso, available at
  *  https://github.com/rfrancotoso/brkgaAPI. The most parts of the code are
@@ -28,20 +28,29 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <atomic>
 #include <exception>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "population.hpp"
 
 namespace BRKGA_ALG {
 
+/// Last rounding_id given by Population::setFitness().
+static std::atomic<uint64_t> last_rounding_id(0);
+
 Population::Population(const Population& pop) :
 		population(pop.population),
-		fitness(pop.fitness)
+		fitness(pop.fitness),
+		elite_histogram(pop.elite_histogram),
+		elite_members(pop.elite_members)
 {}
 
 Population::Population(const unsigned n, const unsigned p) :
-		population(p, Chromosome(n, 0.0)), fitness(p)
+		population(p, Chromosome(n, 0.0)), fitness(p),
+		elite_histogram(), elite_members()
 {
 	if(p == 0)
 	    throw std::range_error("Population size p cannot be zero.");
@@ -79,6 +88,79 @@ Chromosome& Population::getChromosome(unsigned i) {
 void Population::setFitness(unsigned i, double f) {
 	fitness[i].first = f;
 	fitness[i].second = i;
+	population[i].rounding_id = ++last_rounding_id;
+}
+
+const std::vector<int>& Population::getEliteHistogram(unsigned num_elites) const {
+	updateEliteHistogram(num_elites);
+	return elite_histogram;
+}
+
+unsigned Population::getNumDistinctEliteRoundings(unsigned num_elites) const {
+	updateEliteHistogram(num_elites);
+
+	std::unordered_set<std::size_t> hashes;
+	hashes.reserve(elite_members.size());
+	for(const auto &member : elite_members)
+		hashes.insert(member.hash);
+	return hashes.size();
+}
+
+void Population::updateEliteHistogram(unsigned num_elites) const {
+	const std::size_t n = population[0].rounded.size();
+	if(elite_histogram.size() != n) {
+		elite_histogram.assign(n, 0);
+		elite_members.clear();
+	}
+
+	if(num_elites > getP())
+		num_elites = getP();
+
+	// How many times each rounding is in the new elite set.
+	std::unordered_map<uint64_t, unsigned> to_count;
+	to_count.reserve(num_elites);
+	for(unsigned i = 0; i < num_elites; ++i) {
+		const uint64_t id = getChromosome(i).rounding_id;
+		if(id != 0)
+			++to_count[id];
+	}
+
+	// Subtract the members that left the elite set. Unknown roundings
+	// (id zero) are always recounted.
+	std::size_t kept = 0;
+	for(auto &member : elite_members) {
+		auto it = to_count.find(member.rounding_id);
+		if(member.rounding_id != 0 && it != to_count.end() && it->second > 0) {
+			--it->second;
+			std::swap(elite_members[kept++], member);
+			continue;
+		}
+
+		for(std::size_t j = 0; j < n; ++j)
+			elite_histogram[j] -= member.rounding[j];
+	}
+
+	elite_members.erase(elite_members.begin() + kept, elite_members.end());
+
+	// Add the members that entered the elite set.
+	for(unsigned i = 0; i < num_elites; ++i) {
+		const Chromosome &chr = getChromosome(i);
+		if(chr.rounding_id != 0) {
+			auto it = to_count.find(chr.rounding_id);
+			if(it->second == 0)
+				continue;
+			--it->second;
+		}
+
+		std::vector<int> rounding(chr.rounded.begin(), chr.rounded.end());
+		std::size_t hash = 0;
+		for(std::size_t j = 0; j < n; ++j) {
+			elite_histogram[j] += rounding[j];
+			if(rounding[j] == 1)
+				hash ^= j + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+		}
+		elite_members.emplace_back(chr.rounding_id, hash, std::move(rounding));
+	}
 }
 
 Allele Population::operator()(unsigned chromosome, unsigned allele) const {
@@ -8,7 +8,7 @@
  *     All Rights Reserved.
  *
  *  Created on : Jun 21, 2010 by rtoso
- *  Last update: Feb 11, 2015 by andrade
+ *  Last update: Oct 18, 2026 by andrade
 
  *  This software is based on the work of Rodrigo Franco Toso, available at
  *  https://github.com/rfrancotoso/brkgaAPI. The most parts of the code are
@@ -34,6 +34,7 @@
 
 #include <vector>
 #include <utility>
+#include <cstddef>
 #include <stdint.h>
 
 namespace BRKGA_ALG {
@@ -101,6 +102,23 @@ public:
 
     /// Returns i-th best chromosome
     const Chromosome& getChromosome(unsigned i) const;
+
+    /** Returns the histogram of the roundings of the best chromosomes, i.e.,
+     * how many of the num_elites best chromosomes have gene j rounded to one.
+     *
+     * The histogram is kept between calls (and copies) and updated only
+     * with the chromosomes that entered or left the elite set since the
+     * last call, identified by Chromosome::rounding_id. The reference is
+     * valid until the next call. Not thread safe.
+     * \param num_elites number of best chromosomes.
+     */
+    const std::vector<int>& getEliteHistogram(unsigned num_elites) const;
+
+    /** Returns the number of distinct roundings among the num_elites best
+     * chromosomes. Updates the histogram as getEliteHistogram().
+     * \param num_elites number of best chromosomes.
+     */
+    unsigned getNumDistinctEliteRoundings(unsigned num_elites) const;
     //@}
 
     /** Set the type of chromosome
@@ -117,12 +135,33 @@ public:
     /// Fitness (double) of a each chromosome
     std::vector<std::pair<double, unsigned>> fitness;
 
+    /// A chromosome counted in elite_histogram.
+    struct EliteMember {
+        EliteMember(uint64_t _rounding_id, std::size_t _hash,
+                    std::vector<int> _rounding):
+            rounding_id(_rounding_id), hash(_hash),
+            rounding(std::move(_rounding))
+        {}
+
+        uint64_t rounding_id;       ///< Chromosome::rounding_id.
+        std::size_t hash;           ///< Hash of the rounding.
+        std::vector<int> rounding;  ///< Copy of the rounding.
+    };
+
+    /// Histogram of the roundings of the elite chromosomes.
+    /// See getEliteHistogram().
+    mutable std::vector<int> elite_histogram;
+
+    /// The chromosomes counted in elite_histogram.
+    mutable std::vector<EliteMember> elite_members;
+
     /** Sorts 'fitness' by its first parameter by predicate template class.
      * \param maximize if true, sort in non-increasing order.
      */
     void sortFitness(bool maximize);
 
-    /** Sets the fitness of chromosome
+    /** Sets the fitness of chromosome, after it was decoded. It also gives
+     * a new rounding_id to the chromosome.
      * \param i index of chromosome
      * \param f value
      */
@@ -131,6 +170,10 @@ public:
     /// Returns a chromosome
     Chromosome& getChromosome(unsigned i);
 
+    /// Brings elite_histogram and elite_members to the num_elites best
+    /// chromosomes.
+    void updateEliteHistogram(unsigned num_elites) const;
+
     /// Direct access to allele j of chromosome i
     Allele& operator()(unsigned i, unsigned j);
 
@@ -1,5 +1,5 @@
 /******************************************************************************
- * cluster_tree.cpp: Implementation for ClusterNode and ClusterTree classes.
+ * cluster_tree.cpp: Implementation for ClusterTree class.
  *
  * Author: Carlos Eduardo de Andrade
  *         <carlos.andrade@gatech.edu / ce.andrade@gmail.com>
@@ -9,7 +9,7 @@
  *     All Rights Reserved.
  *
  *  Created on : May 26, 2015 by andrade
- *  Last update: Jun 23, 2015 by andrade
+ *  Last update: Oct 18, 2026 by andrade
  *
  * This code is released under LICENSE.md.
  *
@@ -32,80 +32,31 @@
 #include <fstream>
 #include <stdexcept>
 #include <limits>
-#include <queue>
+#include <utility>
 #include <algorithm>
 
 using namespace std;
 
 namespace ce_andrade {
 
-/******************************************************************************
- * ClusterNode methods
- ******************************************************************************/
-
 //------------------[ Default Constructor and Destructor ]--------------------//
 
-ClusterNode::ClusterNode():
-        original_id(numeric_limits<decltype(original_id)>::min()),
-        height(numeric_limits<decltype(height)>::min()),
-        distance(numeric_limits<decltype(distance)>::lowest()),
-        parent(),
-        left(nullptr),
-        right(nullptr),
-        object_names()
-{}
-
-ClusterNode::~ClusterNode() {}
-
-//--------------------------[ Get object names ]------------------------------//
-
-const std::deque<std::string>& ClusterNode::getObjectNames() {
-    // If the names are empty, find the names in the subtrees.
-    if(object_names.empty()) {
-        auto &left_names = left->getObjectNames();
-        copy(begin(left_names), end(left_names), back_inserter(object_names));
-
-        auto &right_names = right->getObjectNames();
-        copy(begin(right_names), end(right_names), back_inserter(object_names));
-    }
-
-    return object_names;
-}
-
-//---------------------[ Print the node and its subtree ]---------------------//
-
-void ClusterNode::print(std::ostream &os, int padding) {
-    string str_padding(4 * padding, ' ');
-    os << "\n" << str_padding;
-    os << "+ " << original_id
-        << " (height: " << height
-        << ", dist: " << distance
-        << ")";
-    os << "\n" << str_padding << "| Items: ";
-    for(auto &name : object_names)
-        cout << name << " ";
-
-    ++padding;
-
-    if(left != nullptr)
-        left->print(os, padding);
-
-    if(right != nullptr)
-        right->print(os, padding);
-}
-
-/******************************************************************************
- * ClusterTree methods
- ******************************************************************************/
-
-//------------------[ Default Constructor and Destructor ]--------------------//
-
-ClusterTree::ClusterTree(std::vector<CClusteringLibNode> &_plain_tree,
-                         const std::vector<std::string> &object_names):
-        root(nullptr),
-        original_leaves(),
+ClusterTree::ClusterTree(std::vector<CClusteringLibNode> &plain_tree,
+                         const std::vector<std::string> &_object_names):
+        num_leaves((int)_object_names.size()),
+        root(-1),
+        node_parent(),
+        node_left(),
+        node_right(),
+        node_distance(),
+        node_height(),
+        preorder(),
+        preorder_position(),
+        leaf_order(),
+        leaf_begin(),
+        leaf_end(),
         current_leaves(),
-        plain_tree(),
+        object_names(_object_names),
         minimum_distance(numeric_limits<double>::max()),
         maximum_distance(numeric_limits<double>::lowest()),
         average_distance(0.0),
@@ -118,96 +69,104 @@ ClusterTree::ClusterTree(std::vector<CClusteringLibNode> &_plain_tree,
          << endl;
     #endif
 
-    // First, take the ownership of the data.
-    plain_tree.swap(_plain_tree);
+    const int num_nodes = num_leaves + (int)plain_tree.size();
+    if(num_leaves == 0 || num_nodes != 2 * num_leaves - 1)
+        throw runtime_error("Invalid cluster tree.");
 
-    original_leaves.reserve(object_names.size());
-    current_leaves.reserve(object_names.size());
-
-    for(int i = 0; i < (int)object_names.size(); ++i) {
-        shared_ptr<ClusterNode> node(new ClusterNode());
-        node->original_id = i;
-        node->object_names.push_back(object_names[i]);
-        original_leaves.push_back(node);
-        current_leaves.push_back(node);
-    }
-
-    vector<shared_ptr<ClusterNode>> intermediate_nodes(plain_tree.size(), nullptr);
+    node_parent.assign(num_nodes, -1);
+    node_left.assign(num_nodes, -1);
+    node_right.assign(num_nodes, -1);
+    node_distance.assign(num_nodes, numeric_limits<double>::lowest());
+    node_height.assign(num_nodes, 0);
 
     // Inner nodes have IDs using negative number. So, we need do some
-    // offsetting to get the right position in intermediate_nodes.
-    // Please, note the minus signals along this block.
-    int id_count = -1;
-    for(auto &plain_node : plain_tree) {
+    // offsetting to get the right position. Please, note the minus signals.
+    auto to_index = [&](const int id) {
+        const int index = (id > -1? id : num_leaves - id - 1);
+        if(index >= num_nodes || node_parent[index] != -1)
+            throw runtime_error("Invalid cluster tree.");
+        return index;
+    };
+
+    for(int i = 0; i < (int)plain_tree.size(); ++i) {
         #ifdef FULLDEBUG
-        cout << "\n Creating node " << id_count << " >"
-             << " left: " << plain_node.left
-             << " right: " << plain_node.right
-             << " distance: " << plain_node.distance;
+        cout << "\n Creating node " << -i - 1 << " >"
+             << " left: " << plain_tree[i].left
+             << " right: " << plain_tree[i].right
+             << " distance: " << plain_tree[i].distance;
         cout.flush();
         #endif
 
-        shared_ptr<ClusterNode> node(new ClusterNode());
-        node->original_id = id_count;
-        intermediate_nodes[-id_count - 1] = node;
-
-        if(plain_node.left > -1)
-            node->left = original_leaves[plain_node.left];
-        else
-            node->left = intermediate_nodes[-plain_node.left - 1];
-
-        if(plain_node.right > -1)
-            node->right = original_leaves[plain_node.right];
-        else
-            node->right = intermediate_nodes[-plain_node.right - 1];
-
-        node->left->parent = node;
-        node->right->parent = node;
-
-        node->distance = plain_node.distance;
-
-        --id_count;
+        const int node = num_leaves + i;
+        const int left = to_index(plain_tree[i].left);
+        const int right = to_index(plain_tree[i].right);
+        node_left[node] = left;
+        node_right[node] = right;
+        node_parent[left] = node;
+        node_parent[right] = node;
+        node_distance[node] = plain_tree[i].distance;
     }
 
-    // Usually, the last node of intermediate_nodes is the root node. But,
-    // to make sure, let's traverse the tree bottom-up from a leaf to the root.
-    weak_ptr<ClusterNode> lookup_node(original_leaves.front());
-    while(!lookup_node.lock()->parent.expired())
-        lookup_node = lookup_node.lock()->parent;
+    // We are done with the plain tree.
+    vector<CClusteringLibNode>().swap(plain_tree);
+
+    // Usually, the last node is the root node. But, to make sure, let's
+    // traverse the tree bottom-up from a leaf to the root.
+    root = 0;
+    while(node_parent[root] != -1)
+        root = node_parent[root];
 
-    root = lookup_node.lock();
+    // Now, one depth-first pass adjusts the heights, lays out the leaves,
+    // and computes some statistics.
+    preorder.reserve(num_nodes);
+    preorder_position.assign(num_nodes, -1);
+    leaf_order.reserve(num_leaves);
+    leaf_begin.assign(num_nodes, 0);
+    leaf_end.assign(num_nodes, 0);
 
-    // Now, we adjust the heights and compute some statistics.
-    root->height = 0;
-    average_distance = root->distance;
+    average_distance = node_distance[root];
 
     vector<double> distances;
-    distances.reserve(plain_tree.size());
+    distances.reserve(num_nodes - num_leaves);
+
+    vector<int> stack;
+    stack.push_back(root);
+    while(!stack.empty()) {
+        const int node = stack.back();
+        stack.pop_back();
+
+        preorder_position[node] = (int)preorder.size();
+        preorder.push_back(node);
+        leaf_begin[node] = (int)leaf_order.size();
+        height = max(height, node_height[node]);
+
+        if(isLeaf(node)) {
+            leaf_order.push_back(node);
+            continue;
+        }
 
-    queue<shared_ptr<ClusterNode>> queue;
-    queue.push(root);
-    while(!queue.empty()) {
-        auto node = queue.front();
-        queue.pop();
+        minimum_distance = std::min(minimum_distance, node_distance[node]);
+        maximum_distance = std::max(maximum_distance, node_distance[node]);
+        average_distance += node_distance[node];
+        distances.push_back(node_distance[node]);
 
-        height = max(height, node->height);
+        node_height[node_left[node]] = node_height[node] + 1;
+        node_height[node_right[node]] = node_height[node] + 1;
 
-        if(node->left != nullptr || node->right != nullptr) {
-            minimum_distance = std::min(minimum_distance, node->distance);
-            maximum_distance = std::max(maximum_distance, node->distance);
-            average_distance += node->distance;
-            distances.push_back(node->distance);
-        }
+        // Left first.
+        stack.push_back(node_right[node]);
+        stack.push_back(node_left[node]);
+    }
 
-        if(node->left != nullptr) {
-            node->left->height = node->height + 1;
-            queue.push(node->left);
-        }
+    if((int)preorder.size() != num_nodes)
+        throw runtime_error("Invalid cluster tree.");
 
-        if(node->right != nullptr) {
-            node->right->height = node->height + 1;
-            queue.push(node->right);
-        }
+    // The right subtree comes after the left one. So, the leaves of a node
+    // end where the leaves of its right child end.
+    for(int p = num_nodes - 1; p >= 0; --p) {
+        const int node = preorder[p];
+        leaf_end[node] = (isLeaf(node)? leaf_begin[node] + 1 :
+                                        leaf_end[node_right[node]]);
     }
 
     // height = last_level + 1
@@ -215,8 +174,14 @@ ClusterTree::ClusterTree(std::vector<CClusteringLibNode> &_plain_tree,
 
     average_distance /= distances.size() + 1;
 
-    nth_element(begin(distances), begin(distances) + (distances.size() / 2), end(distances));
-    median_distance = *(begin(distances) + (distances.size() / 2));
+    if(!distances.empty()) {
+        nth_element(begin(distances), begin(distances) + (distances.size() / 2), end(distances));
+        median_distance = *(begin(distances) + (distances.size() / 2));
+    }
+
+    current_leaves.resize(num_leaves);
+    for(int i = 0; i < num_leaves; ++i)
+        current_leaves[i] = i;
 }
 
 ClusterTree::~ClusterTree() {}
@@ -224,24 +189,60 @@ ClusterTree::~ClusterTree() {}
 //---------------------------[ Compact tree ]---------------------------------//
 
 void ClusterTree::compactTree(const Compaction type, const double value) {
-    queue<shared_ptr<ClusterNode>> queue;
-    queue.push(root);
     current_leaves.clear();
 
-    while(!queue.empty()) {
-        auto node = queue.front();
-        queue.pop();
+    // A new leaf skips its whole subtree (2 * leaves - 1 nodes).
+    for(int p = 0; p < (int)preorder.size(); ) {
+        const int node = preorder[p];
 
-        if((type == Compaction::BY_LEVEL && node->height < (decltype(node->height))value) ||
-           (type == Compaction::BY_DISTANCE && node->distance > value)) {
-
-            if(node->left != nullptr)
-                queue.push(node->left);
-            if(node->right != nullptr)
-                queue.push(node->right);
+        if(!isLeaf(node) &&
+           ((type == Compaction::BY_LEVEL && node_height[node] < (int)value) ||
+            (type == Compaction::BY_DISTANCE && node_distance[node] > value))) {
+            ++p;
         }
-        else
+        else {
             current_leaves.push_back(node);
+            p += 2 * getNumObjects(node) - 1;
+        }
+    }
+}
+
+//--------------------------[ Get object names ]------------------------------//
+
+std::vector<std::string> ClusterTree::getObjectNames(const int node) const {
+    vector<string> names;
+    names.reserve(getNumObjects(node));
+    for(auto it = objectsBegin(node); it != objectsEnd(node); ++it)
+        names.push_back(object_names[*it]);
+    return names;
+}
+
+//---------------------[ Print the node and its subtree ]---------------------//
+
+void ClusterTree::print(std::ostream &os, const int node) const {
+    // Single linkage trees can be very deep. So, no recursion here.
+    vector<pair<int, int>> stack;
+    stack.emplace_back(node, 0);
+
+    while(!stack.empty()) {
+        const int current = stack.back().first;
+        const int padding = stack.back().second;
+        stack.pop_back();
+
+        string str_padding(4 * padding, ' ');
+        os << "\n" << str_padding;
+        os << "+ " << getOriginalId(current)
+            << " (height: " << node_height[current]
+            << ", dist: " << node_distance[current]
+            << ")";
+        os << "\n" << str_padding << "| Items: ";
+        for(auto it = objectsBegin(current); it != objectsEnd(current); ++it)
+            os << object_names[*it] << " ";
+
+        if(!isLeaf(current)) {
+            stack.emplace_back(node_right[current], padding + 1);
+            stack.emplace_back(node_left[current], padding + 1);
+        }
     }
 }
 
@@ -256,14 +257,13 @@ std::ostream& operator<<(std::ostream &os, const ClusterTree &tree) {
        << "\n- median: " << tree.median_distance
        << "\n";
 
-//    if(tree.root != nullptr)
-//        tree.root->print(os);
+//    tree.print(os, tree.root);
     return os;
 }
 
 //---------------------------[ Save to Graphviz ]-----------------------------//
 
-void ClusterTree::saveToGraphviz(const string filename) {
+void ClusterTree::saveToGraphviz(const string filename) const {
     const string PADDING(4, ' ');
     ofstream dot_file(filename, ios::trunc);
 
@@ -275,33 +275,23 @@ void ClusterTree::saveToGraphviz(const string filename) {
              << "digraph \"0\" {\n";
 
     // First, we describe the leaves
-    for(auto &leaf : original_leaves) {
+    for(int leaf = 0; leaf < num_leaves; ++leaf) {
         dot_file << PADDING
-                 << leaf->original_id
-                 << " [label=\"" << leaf->getObjectNames().front() << "\","
+                 << leaf
+                 << " [label=\"" << object_names[leaf] << "\","
                  << " style=\"filled\", fillcolor=\"#C4C400\"];\n";
     }
 
-    queue<shared_ptr<ClusterNode>> queue;
-    queue.push(root);
+    for(const auto node : preorder) {
+        if(isLeaf(node))
+            continue;
 
-    while(!queue.empty()) {
-        auto node = queue.front();
-        queue.pop();
-
-        if(node->left != nullptr) {
-            dot_file << PADDING
-                     << node->original_id << " -> " << node->left->original_id
-                     << ";\n";
-            queue.push(node->left);
-        }
-
-        if(node->right != nullptr) {
-            dot_file << PADDING
-                     << node->original_id << " -> " << node->right->original_id
-                     << ";\n";
-            queue.push(node->right);
-        }
+        dot_file << PADDING
+                 << getOriginalId(node) << " -> " << getOriginalId(node_left[node])
+                 << ";\n"
+                 << PADDING
+                 << getOriginalId(node) << " -> " << getOriginalId(node_right[node])
+                 << ";\n";
     }
 
     dot_file << "}\n";
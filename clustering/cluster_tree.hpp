@@ -1,5 +1,5 @@
 /******************************************************************************
- * cluster_tree.hpp: Interface for ClusterNode and ClusterTree classes.
+ * cluster_tree.hpp: Interface for ClusterTree class.
  *
  * Author: Carlos Eduardo de Andrade
  *         <carlos.andrade@gatech.edu / ce.andrade@gmail.com>
@@ -9,7 +9,7 @@
  *     All Rights Reserved.
  *
  *  Created on : May 26, 2015 by andrade
- *  Last update: Jun 23, 2015 by andrade
+ *  Last update: Oct 18, 2026 by andrade
  *
  * This code is released under LICENSE.md.
  *
@@ -30,92 +30,26 @@
 #define CLUSTER_TREE_HPP_
 
 #include <iostream>
-#include <deque>
+#include <string>
 #include <vector>
-#include <memory>
 
 namespace ce_andrade {
 
-// Forward declaration.
-class ClusterTree;
-
 /**
- * \brief ClusterNode
+ * \brief ClusterTree
  *
  * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
  * \date 2015
  *
- * This class represents a node in the clusterization tree.
- */
-class ClusterNode {
-    friend class ClusterTree;
-
-    public:
-        /** \name Constructor and Destructor */
-        //@{
-        /// Default Constructor.
-        ClusterNode();
-
-        /// Destructor.
-        ~ClusterNode();
-        //@}
-
-        /** \name Informational methods */
-        //@{
-        /// Returns the name of objects under the subtrees.
-        /// \return a list with the names.
-        const std::deque<std::string>& getObjectNames();
-
-        /** \brief Print the instance on ostream output.
-         * \param os the output object
-         * \param padding used to adjust the padding in the print.
-         */
-        void print(std::ostream &os, int padding = 0);
-        //@}
-
-    public:
-        /** \name Data
-         * We decided to give free access to internal data to speed up a little
-         * bit the utilization of this data. PLEASE, USE THEM WITH CARE!
-         */
-        //@{
-        /// ID of the node from C clustegin library. For leaves with just
-        /// one element, the ID is mininum integer.
-        int original_id;
-
-        /// The height in the tree. The root node is
-        int height;
-
-        /// The distance between the two items or subnodes that were joined.
-        double distance;
-
-        /// The parent node. If nullptr is there is the root node.
-        std::weak_ptr<ClusterNode> parent;
-
-        /// The left child. If nullptr is there is no such child.
-        std::shared_ptr<ClusterNode> left;
-
-        /// The right child. If nullptr is there is no such child.
-        std::shared_ptr<ClusterNode> right;
-        //@}
-
-    protected:
-        /** Internal data */
-        //@{
-        /// Describes all objects (variables or constraints names) under
-        /// this node. It is built in lazy fashion. So, this is the reason
-        /// to no be public.
-        std::deque<std::string> object_names;
-        //@}
-};
-
-/**
- * \brief ClusterNode
- *
- * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
- * \date 2015
+ * This class represents the clusterization tree. The tree is stored in flat
+ * form: each node is an index, and its data are in parallel arrays. Nodes
+ * [0, num_leaves) are the leaves (objects) and the following ones are the
+ * inner nodes in the order they came from the clustering algorithm.
  *
- * This class represents a node in the clusterization tree.
+ * The leaves are stored in depth-first order (ClusterTree::leaf_order), so
+ * the leaves under any node are a contiguous span of that array
+ * (ClusterTree::leaf_begin and ClusterTree::leaf_end). The object names
+ * are resolved by index only when needed.
  */
 class ClusterTree {
     public:
@@ -149,8 +83,9 @@ class ClusterTree {
         /** \name Constructor and Destructor */
         //@{
         /** \brief Default Constructor.
-         * \param plain_tree from the clustering algorithm. This class takes
-         *        the ownership of the data swapping the vectors.
+         * \param plain_tree from the clustering algorithm. Leaves are
+         *        referred by their indices and node i by -i - 1. This
+         *        vector is consumed (left empty).
          * \param object_names the names of variables or constraints.
          */
         ClusterTree(std::vector<CClusteringLibNode> &plain_tree,
@@ -164,13 +99,15 @@ class ClusterTree {
         //@{
         /** \brief This method collapses nodes resulting in new leaves.
          * This method DOES NOT CHANGE THE TREE. It only changes
-         * ClusterTree::current_leaves. The tree is yet full accessible through
-         * ClusterTree::root and ClusterTree::original_leaves.
+         * ClusterTree::current_leaves. The tree is yet full accessible.
+         * It is a single pass over the nodes in depth-first order, skipping
+         * the subtrees of the new leaves.
          *
          * \param type define the type of compaction. If BY_LEVEL, nodes with
          * level higher than or equal to the "value" parameter are compacted
          * and became new leaves. If BY_DISTANCE, nodes whose the distance
          * between their subtrees are at most min_dist are compacted.
+         * Original leaves are never expanded.
          *
          * \param value the value used in the compaction.
          */
@@ -179,6 +116,53 @@ class ClusterTree {
 
         /** \name Informational methods */
         //@{
+        /// Returns the total number of nodes.
+        int getNumNodes() const {
+            return (int)node_parent.size();
+        }
+
+        /// Indicates if the node is an original leaf.
+        bool isLeaf(const int node) const {
+            return node < num_leaves;
+        }
+
+        /// Returns the ID of the node in the C clustering library
+        /// convention: the object index for leaves and -i - 1 for inner
+        /// node i.
+        int getOriginalId(const int node) const {
+            return (node < num_leaves? node : num_leaves - node - 1);
+        }
+
+        /// Returns the number of objects under the node.
+        int getNumObjects(const int node) const {
+            return leaf_end[node] - leaf_begin[node];
+        }
+
+        /// Returns an iterator to the first object (leaf index) under the node.
+        std::vector<int>::const_iterator objectsBegin(const int node) const {
+            return leaf_order.begin() + leaf_begin[node];
+        }
+
+        /// Returns an iterator past the last object under the node.
+        std::vector<int>::const_iterator objectsEnd(const int node) const {
+            return leaf_order.begin() + leaf_end[node];
+        }
+
+        /// Returns the name of an object (leaf).
+        const std::string& getObjectName(const int leaf) const {
+            return object_names[leaf];
+        }
+
+        /// Returns the name of objects under the subtree.
+        /// \return a list with the names, built on demand.
+        std::vector<std::string> getObjectNames(const int node) const;
+
+        /** \brief Print a node and its subtree on ostream output.
+         * \param os the output object
+         * \param node the subtree's root.
+         */
+        void print(std::ostream &os, const int node) const;
+
         /** \brief Print the instance on std::ostream output.
          * \param os the output object
          * \param tree the tree.
@@ -188,7 +172,7 @@ class ClusterTree {
         /** \brief Create a Graphviz file from the tree.
          * \param filename the file to save the tree.
          */
-        void saveToGraphviz(const std::string filename);
+        void saveToGraphviz(const std::string filename) const;
         //@}
 
     public:
@@ -197,17 +181,50 @@ class ClusterTree {
          * bit the utilization of this data. PLEASE, USE THEM WITH CARE!
          */
         //@{
+        /// Number of original leaves, i.e., objects.
+        int num_leaves;
+
         /// The root node of the tree.
-        std::shared_ptr<ClusterNode> root;
+        int root;
+
+        /// The parent of each node. -1 for the root.
+        std::vector<int> node_parent;
+
+        /// The left child of each node. -1 for leaves.
+        std::vector<int> node_left;
+
+        /// The right child of each node. -1 for leaves.
+        std::vector<int> node_right;
+
+        /// The distance between the two subtrees joined in each node. The
+        /// lowest double for leaves.
+        std::vector<double> node_distance;
+
+        /// The height (depth) of each node. The root node has height 0.
+        std::vector<int> node_height;
+
+        /// The nodes in depth-first order (left subtree first).
+        std::vector<int> preorder;
+
+        /// The position of each node in ClusterTree::preorder. The subtree
+        /// of node v is preorder[preorder_position[v] ..
+        /// preorder_position[v] + 2 * getNumObjects(v) - 1).
+        std::vector<int> preorder_position;
+
+        /// The original leaves in depth-first order.
+        std::vector<int> leaf_order;
+
+        /// The leaves under node v are leaf_order[leaf_begin[v] .. leaf_end[v]).
+        std::vector<int> leaf_begin;
 
-        /// The original leaves from the clusterization.
-        std::vector<std::shared_ptr<ClusterNode>> original_leaves;
+        /// See ClusterTree::leaf_begin.
+        std::vector<int> leaf_end;
 
         /// The current leaves after compression(s).
-        std::vector<std::shared_ptr<ClusterNode>> current_leaves;
+        std::vector<int> current_leaves;
 
-        /// Holds the results of clustering algorithm.
-        std::vector<CClusteringLibNode> plain_tree;
+        /// The names of the objects (variables or constraints).
+        std::vector<std::string> object_names;
 
         /// Minimum distance between the nodes. It also includes
         /// the distance between intermediate nodes.
@@ -27,6 +27,9 @@
  ******************************************************************************/
 
 #include "clusterator.hpp"
+#include "distance_kernels.hpp"
+#include "matrix_file.hpp"
+#include "single_linkage.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -34,6 +37,7 @@
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
+#include <cmath>
 
 #include "c_clustering_library/cluster.h"
 
@@ -43,6 +47,23 @@ namespace ce_andrade {
 
 const double EPS = 1e-10;
 
+//-----------------------------[ Sparse rows ]--------------------------------//
+
+/// Write a row of a sparse matrix in dense form, including the zeros.
+template <typename SparseMatrix>
+static void writeDenseRow(ostream &os, const SparseMatrix &matrix,
+                          const typename SparseMatrix::Index row) {
+    typename SparseMatrix::Index col = 0;
+    for(typename SparseMatrix::InnerIterator it(matrix, row); it; ++it) {
+        for(; col < it.index(); ++col)
+            os << 0.0 << " ";
+        os << it.value() << " ";
+        ++col;
+    }
+    for(; col < matrix.cols(); ++col)
+        os << 0.0 << " ";
+}
+
 //------------------[ Default Constructor and Destructor ]--------------------//
 
 Clusterator::Clusterator():
@@ -54,17 +75,117 @@ Clusterator::Clusterator():
         num_vars(0),
         num_ctrs(0),
         variable_names(),
-        constraint_names()
+        constraint_names(),
+        distance_file_prefix(),
+        min_sharing(1.0),
+        sharing_matrices_built(false),
+        lsh_bands(20),
+        lsh_rows_per_band(5),
+        evaluated_pairs_fraction(1.0),
+        output_format(OutputFormat::ASCII)
 {
     Eigen::initParallel();
 }
 
 Clusterator::~Clusterator() {}
 
+//------------------------[ Distance matrices memory ]------------------------//
+
+void Clusterator::mapDistanceMatrices(const string &file_prefix) {
+    distance_file_prefix = file_prefix;
+}
+
+void Clusterator::allocateDistanceMatrix(DistanceMatrix &matrix, const IloInt size,
+                                         const string &name) {
+    if(distance_file_prefix.empty())
+        matrix.resize(size);
+    else
+        matrix.resizeMapped(size, distance_file_prefix + "_" + name + ".dist");
+}
+
+//-----------------------------[ Sharings ]-----------------------------------//
+
+/// Count, for each pair of rows a > b of matrix, the number of columns they
+/// have in common, i.e., the strict lower triangle of matrix * matrix^T
+/// (only the pattern is used). The rows are split among the threads
+/// (Gustavson's row-by-row product, with one dense accumulator per thread)
+/// and each count is written straight to dist(a, b), so the product is
+/// never stored. Counts smaller than min_sharing are not written at all.
+/// \param matrix the row-major pattern.
+/// \param transpose the transpose of matrix, also row-major.
+/// \param dist where the counts are written.
+/// \param min_sharing smallest count to be written.
+/// \return the largest count written.
+template <typename SparseMatrix, typename DistanceMatrix>
+static double countSharings(const SparseMatrix &matrix, const SparseMatrix &transpose,
+                            DistanceMatrix &dist, const double min_sharing) {
+    typedef typename SparseMatrix::Index IndexType;
+    const IndexType N = matrix.rows();
+    double max_sharing = 0.0;
+
+    #ifdef _OPENMP
+    #pragma omp parallel
+    #endif
+    {
+        vector<unsigned> count(N, 0);
+        vector<IndexType> touched;
+        double local_max = 0.0;
+
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 64)
+        #endif
+        for(IndexType a = 1; a < N; ++a) {
+            for(typename SparseMatrix::InnerIterator it(matrix, a); it; ++it) {
+                for(typename SparseMatrix::InnerIterator jt(transpose, it.index());
+                    jt && jt.index() < a; ++jt) {
+                    if(count[jt.index()]++ == 0)
+                        touched.push_back(jt.index());
+                }
+            }
+
+            for(const auto b : touched) {
+                if(count[b] >= min_sharing) {
+                    dist(a, b) = count[b];
+                    if(local_max < count[b])
+                        local_max = count[b];
+                }
+                count[b] = 0;
+            }
+            touched.clear();
+        }
+
+        #ifdef _OPENMP
+        #pragma omp critical
+        #endif
+        if(max_sharing < local_max)
+            max_sharing = local_max;
+    }
+
+    return max_sharing;
+}
+
+/// Turn the sharing counts into distances: dist(a, b) = 1 - count / max.
+/// Objects sharing nothing get distance 1.0.
+template <typename DistanceMatrix>
+static void normalizeSharings(DistanceMatrix &dist, const double max_sharing) {
+    typedef decltype(dist.getSize()) IndexType;
+    const IndexType N = dist.getSize();
+    const double factor = (max_sharing > 0.0? 1.0 / max_sharing : 0.0);
+
+    // Remember, skip the diagonal.
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 64)
+    #endif
+    for(IndexType i = 1; i < N; ++i)
+        for(IndexType j = 0; j < i; ++j)
+            dist(i, j) = 1.0 - dist(i, j) * factor;
+}
+
 //-----------------------[ Build distance matrices ]--------------------------//
 
 void Clusterator::buildIncidenceMatrices(const IloNumVarArray &variables,
-               const IloRangeArray &constraints, string output_file_preffix) {
+               const IloRangeArray &constraints, string output_file_preffix,
+               const double min_sharing) {
     #ifdef DEBUG
     cout << "\n--------------------------------\n"
          << "> Building distance matrices..."
@@ -75,10 +196,11 @@ void Clusterator::buildIncidenceMatrices(const IloNumVarArray &variables,
     num_vars = variables.getSize();
     num_ctrs = constraints.getSize();
 
-    weighted_incidence_matrix = Eigen::MatrixXd::Zero(num_vars, num_ctrs);
-    incidence_matrix = Eigen::MatrixXd::Zero(num_vars, num_ctrs);
-    variables_distance.resize(num_vars);
-    constraints_distance.resize(num_ctrs);
+    weighted_incidence_matrix.resize(num_vars, num_ctrs);
+    incidence_matrix.resize(num_vars, num_ctrs);
+
+    this->min_sharing = min_sharing;
+    sharing_matrices_built = false;
 
     #ifdef DEBUG
     cout << "\n> Mapping variable IDs..." << endl;
@@ -104,48 +226,25 @@ void Clusterator::buildIncidenceMatrices(const IloNumVarArray &variables,
     cout << "> Building the matrices..." << endl;
     #endif
 
-    vector<IloInt> vars_in_ctr;
-    vars_in_ctr.reserve(variables.getSize());
-
-    vector<set<IloInt>> var_per_constraint;
-    var_per_constraint.resize(num_ctrs);
-
-    double max_ctr_sharing = 0.0;
+    // The matrices are assembled from (variable, constraint, value) triplets.
+    typedef Eigen::Triplet<double> Entry;
+    vector<Entry> weighted_entries;
+    vector<Entry> entries;
 
-    // First, build the weighted incidence matrix.
     for(IloInt i = 0; i < num_ctrs; ++i) {
-        auto rhs = constraints[i].getUB();
-        if(rhs == IloInfinity)
-            rhs = constraints[i].getLB();
-
         for(auto it = constraints[i].getLinearIterator(); it.ok(); ++it) {
-            weighted_incidence_matrix(variables_id_index[it.getVar().getId()], i) = it.getCoef();
-            vars_in_ctr.push_back(it.getVar().getId());
-            var_per_constraint[i].insert(it.getVar().getId());
-        }
-
-        // Sometimes, the constraint is just empty. So, we just skip.
-        if(vars_in_ctr.empty())
-            continue;
-
-        // Build the distance_matrix
-        for(auto it1 = vars_in_ctr.begin(); it1 != vars_in_ctr.end() - 1; ++it1) {
-            for(auto it2 = it1 + 1; it2 != vars_in_ctr.end(); ++it2) {
-                auto &value = variables_distance(variables_id_index[*it1],
-                                                 variables_id_index[*it2]);
-                value += 1.0;
-                if(max_ctr_sharing < value)
-                    max_ctr_sharing = value;
-            }
+            const IloInt var_idx = variables_id_index[it.getVar().getId()];
+            weighted_entries.emplace_back(var_idx, i, it.getCoef());
+            if(it.getCoef() > EPS)
+                entries.emplace_back(var_idx, i, 1.0);
         }
-        vars_in_ctr.clear();
     }
 
-    // Building the incidence matrix
-    for(IloInt i = 0; i < num_vars; ++i)
-        for(IloInt j = 0; j < num_ctrs; ++j)
-            if(weighted_incidence_matrix(i, j) > EPS)
-                incidence_matrix(i, j) = 1.0;
+    weighted_incidence_matrix.setFromTriplets(weighted_entries.begin(),
+                                              weighted_entries.end());
+    incidence_matrix.setFromTriplets(entries.begin(), entries.end());
+    vector<Entry>().swap(weighted_entries);
+    vector<Entry>().swap(entries);
 
     #ifdef FULLDEBUG
     cout << "\n- incidence_matrix:\n"
@@ -156,63 +255,21 @@ void Clusterator::buildIncidenceMatrices(const IloNumVarArray &variables,
          << weighted_incidence_matrix
          << endl;
     #endif
-    #ifdef DEBUG
-    cout << "\n> Normalizing variables_distance (max_sharing = "
-         << max_ctr_sharing << ")" << "..." << endl;
-    #endif
-
-    // Remember, skip the diagonal.
-    for(IloInt i = 1; i < num_vars; ++i)
-        for(IloInt j = 0; j < i; ++j)
-            variables_distance(i,j) = 1.0 - (variables_distance(i,j) / max_ctr_sharing);
 
-    #ifdef FULLDEBUG
-    cout << "\n- variables_distance:\n"
-         << variables_distance
-         << endl;
-    #endif
-    #ifdef DEBUG
-    cout << "\n> Building constraints_distance..." << endl;
-    #endif
-
-    // Let's do in the old way (oh yes, this is STL adapted)
-    double max_var_sharing = 0.0;
-    for(IloInt i = 0; i < num_ctrs - 1; ++i) {
-        for(IloInt j = i + 1; j < num_ctrs; ++j) {
-            auto first1 = var_per_constraint[i].begin();
-            auto first2 = var_per_constraint[j].begin();
-            const auto last1 = var_per_constraint[i].end();
-            const auto last2 = var_per_constraint[j].end();
-
-            IloInt num_vars_shared = 0;
-            while(first1 != last1 && first2 != last2) {
-                if(*first1 < *first2) ++first1;
-                else if(*first2 < *first1) ++first2;
-                else {
-                    ++num_vars_shared; ++first1; ++first2;
-                }
-            }
-
-            constraints_distance(i,j) = num_vars_shared;
-            if(max_var_sharing < (double)num_vars_shared)
-                max_var_sharing = num_vars_shared;
-        }
-    }
+    #ifndef TUNING
+    if(output_file_preffix.empty())
+        return;
 
-    // Remember, skip the diagonal.
-    for(IloInt i = 1; i < num_ctrs; ++i)
-        for(IloInt j = 0; j < i; ++j)
-            constraints_distance(i,j) = 1.0 - (constraints_distance(i,j) / max_var_sharing);
+    buildSharingMatrices();
 
-    #ifdef FULLDEBUG
-    cout << "\n- constraints_distance:\n"
-         << constraints_distance
-         << endl;
-    #endif
+    if(output_format == OutputFormat::BINARY) {
+        writeBinaryMatrices(output_file_preffix);
 
-    #ifndef TUNING
-    if(output_file_preffix.empty())
+        #ifdef DEBUG
+        cout << "--------------------------------\n" << endl;
+        #endif
         return;
+    }
 
     string incidence_matrix_name(output_file_preffix + "_incidence_matrix.dat");
     string weighted_incidence_matrix_name(output_file_preffix + "_weighted_incidence_matrix.dat");
@@ -235,14 +292,7 @@ void Clusterator::buildIncidenceMatrices(const IloNumVarArray &variables,
     for(IloInt i = 0; i < variables.getSize(); ++i) {
         weighted_incidence_matrix_file << variables[i].getName() << " ";
 
-        // This works but give us a lot of undesirable white spaces
-        //weighted_incidence_matrix_file << weighted_incidence_matrix.row(i) << "\n";
-
-        // So, let do it in the traditional way
-        auto row = weighted_incidence_matrix.row(i);
-        for(IloInt j = 0; j < constraints.getSize(); ++j)
-            weighted_incidence_matrix_file << row(j) << " ";
-
+        writeDenseRow(weighted_incidence_matrix_file, weighted_incidence_matrix, i);
         weighted_incidence_matrix_file << "\n";
     }
 
@@ -266,10 +316,7 @@ void Clusterator::buildIncidenceMatrices(const IloNumVarArray &variables,
     for(IloInt i = 0; i < variables.getSize(); ++i) {
         incidence_matrix_file << variables[i].getName() << " ";
 
-        auto row = weighted_incidence_matrix.row(i);
-        for(IloInt j = 0; j < constraints.getSize(); ++j)
-            incidence_matrix_file << (row(j) < EPS? 0.0 : 1.0) << " ";
-
+        writeDenseRow(incidence_matrix_file, incidence_matrix, i);
         incidence_matrix_file  << "\n";
     }
 
@@ -306,103 +353,284 @@ void Clusterator::buildIncidenceMatrices(const IloNumVarArray &variables,
     #endif
 }
 
-//-----------------------[ Hierarchical clustering ]--------------------------//
+//---------------------------[ Binary matrices ]------------------------------//
+
+void Clusterator::writeBinaryMatrices(const string &file_prefix) {
+    const string weighted_incidence_matrix_name(file_prefix + "_weighted_incidence_matrix.bin");
+    const string incidence_matrix_name(file_prefix + "_incidence_matrix.bin");
+    const string variables_distance_name(file_prefix + "_variables_distance.bin");
+    const string constraints_distance_name(file_prefix + "_constraints_distance.bin");
+
+    #ifdef DEBUG
+    cout << "> Writing " << weighted_incidence_matrix_name << "..." << endl;
+    #endif
+    MatrixFile::writeSparse(weighted_incidence_matrix_name, weighted_incidence_matrix,
+                            variable_names, constraint_names);
+
+    #ifdef DEBUG
+    cout << "> Writing " << incidence_matrix_name << "..." << endl;
+    #endif
+    MatrixFile::writeSparse(incidence_matrix_name, incidence_matrix,
+                            variable_names, constraint_names);
+
+    #ifdef DEBUG
+    cout << "> Writing " << variables_distance_name << "..." << endl;
+    #endif
+    MatrixFile::writePackedTriangle(variables_distance_name, variables_distance,
+                                    variable_names, min_sharing);
+
+    #ifdef DEBUG
+    cout << "> Writing " << constraints_distance_name << "..." << endl;
+    #endif
+    MatrixFile::writePackedTriangle(constraints_distance_name, constraints_distance,
+                                    constraint_names, min_sharing);
+}
+
+void Clusterator::loadMatrices(const string &file_prefix) {
+    const string weighted_incidence_matrix_name(file_prefix + "_weighted_incidence_matrix.bin");
+    const string incidence_matrix_name(file_prefix + "_incidence_matrix.bin");
+    const string variables_distance_name(file_prefix + "_variables_distance.bin");
+    const string constraints_distance_name(file_prefix + "_constraints_distance.bin");
 
-std::shared_ptr<ClusterTree> Clusterator::hierarchicalClustering(
-                            const ClusteringObject type, const Metric metric) {
     #ifdef DEBUG
     cout << "\n--------------------------------\n"
-         << "> Performing hierarchical clustering..."
+         << "> Loading matrices from " << file_prefix << "_*.bin..."
          << endl;
     #endif
 
-    // Transpose the incidence matrix in case of constraint clustering.
-    if(type == ClusteringObject::CONSTRAINT) {
-        if(metric == Metric::L1 || metric == Metric::L2)
-            incidence_matrix.transposeInPlace();
-        else
-            weighted_incidence_matrix.transposeInPlace();
-    }
+    vector<string> row_names, col_names;
+    MatrixFile::readSparse(incidence_matrix_name, incidence_matrix,
+                           row_names, col_names);
+    MatrixFile::readSparse(weighted_incidence_matrix_name, weighted_incidence_matrix,
+                           variable_names, constraint_names);
+
+    if(row_names != variable_names || col_names != constraint_names)
+        throw runtime_error(string("Inconsistent matrix files: ") + file_prefix);
+
+    num_vars = weighted_incidence_matrix.rows();
+    num_ctrs = weighted_incidence_matrix.cols();
+
+    variables_distance.resize(0);
+    constraints_distance.resize(0);
+    sharing_matrices_built = false;
+
+    if(!ifstream(variables_distance_name.c_str()) ||
+       !ifstream(constraints_distance_name.c_str()))
+        return;
+
+    min_sharing = MatrixFile::readPackedTriangle(variables_distance_name,
+                                                 variables_distance, row_names);
+    MatrixFile::readPackedTriangle(constraints_distance_name,
+                                   constraints_distance, col_names);
+
+    if(variables_distance.getSize() != num_vars ||
+       constraints_distance.getSize() != num_ctrs)
+        throw runtime_error(string("Inconsistent matrix files: ") + file_prefix);
+
+    sharing_matrices_built = true;
 
     #ifdef DEBUG
-    switch(metric) {
-    case Clusterator::Metric::L1:
-        cout << "> Computing L1...";
-        break;
-    case Clusterator::Metric::L2:
-        cout << "> Computing L2...";
-        break;
-    case Clusterator::Metric::WEIGHTED_L1:
-        cout << "> Computing weighted L1...";
-        break;
-    case Clusterator::Metric::WEIGHTED_L2:
-        cout << "> Computing weighted L2...";
-        break;
-    default:
-        break;
-    }
-    cout << endl;
+    cout << "--------------------------------\n" << endl;
     #endif
+}
+
+//-----------------------[ Build sharing matrices ]---------------------------//
 
-    switch(metric) {
-    case Clusterator::Metric::L1:
-        computeL1Distance(incidence_matrix);
-        break;
+void Clusterator::buildSharingMatrices() {
+    if(sharing_matrices_built)
+        return;
 
-    case Clusterator::Metric::L2:
-        computeL2Distance(incidence_matrix);
-        break;
+    #ifdef DEBUG
+    cout << "\n> Building variables_distance..." << endl;
+    #endif
 
-    case Clusterator::Metric::WEIGHTED_L1:
-        computeL1Distance(weighted_incidence_matrix);
-        break;
+    allocateDistanceMatrix(variables_distance, num_vars, "variables");
+    allocateDistanceMatrix(constraints_distance, num_ctrs, "constraints");
 
-    case Clusterator::Metric::WEIGHTED_L2:
-        computeL2Distance(weighted_incidence_matrix);
-        break;
+    // Each row of this one holds the (sorted) variables of a constraint.
+    const IncidenceMatrix var_per_constraint(weighted_incidence_matrix.transpose());
 
-    default:
-        break;
-    }
+    // Build the distance_matrix: the sharings are the off-diagonal entries
+    // of A * A^T, where A is the pattern of weighted_incidence_matrix.
+    const double max_ctr_sharing =
+            countSharings(weighted_incidence_matrix, var_per_constraint,
+                          variables_distance, min_sharing);
 
     #ifdef DEBUG
-    cout << "> Clustering..." << endl;
+    cout << "\n> Normalizing variables_distance (max_sharing = "
+         << max_ctr_sharing << ")" << "..." << endl;
     #endif
 
-    IncidenceMatrix *inc_matrix;
-    DistanceMatrix *dist_matrix;
+    normalizeSharings(variables_distance, max_ctr_sharing);
 
-    if(metric == Metric::L1 || metric == Metric::L2)
-        inc_matrix = &incidence_matrix;
-    else
-        inc_matrix = &weighted_incidence_matrix;
+    #ifdef FULLDEBUG
+    cout << "\n- variables_distance:\n"
+         << variables_distance
+         << endl;
+    #endif
+    #ifdef DEBUG
+    cout << "\n> Building constraints_distance..." << endl;
+    #endif
 
-    if(metric == Metric::SHARED) {
-        if(type == ClusteringObject::VARIABLE)
-            dist_matrix = &variables_distance;
-        else
-            dist_matrix = &constraints_distance;
-    }
-    else
-        dist_matrix = &metric_distance;
+    // Now, A^T * A.
+    const double max_var_sharing =
+            countSharings(var_per_constraint, weighted_incidence_matrix,
+                          constraints_distance, min_sharing);
+
+    normalizeSharings(constraints_distance, max_var_sharing);
+
+    #ifdef FULLDEBUG
+    cout << "\n- constraints_distance:\n"
+         << constraints_distance
+         << endl;
+    #endif
+
+    sharing_matrices_built = true;
+}
+
+//-------------------------[ MinHash parameters ]----------------------------//
+
+void Clusterator::setMinHashParameters(const int bands, const int rows_per_band) {
+    if(bands < 1 || rows_per_band < 1)
+        throw std::runtime_error("Invalid MinHash parameters.");
+
+    lsh_bands = bands;
+    lsh_rows_per_band = rows_per_band;
+}
+
+//-----------------------[ Hierarchical clustering ]--------------------------//
+
+std::shared_ptr<ClusterTree> Clusterator::hierarchicalClustering(
+                            const ClusteringObject type, const Metric metric,
+                            const ClusteringEngine engine) {
+    #ifdef DEBUG
+    cout << "\n--------------------------------\n"
+         << "> Performing hierarchical clustering..."
+         << endl;
+    #endif
 
-    Node* plain_tree = treecluster((int)inc_matrix->rows(), (int)inc_matrix->cols(),
-                                   NULL, NULL, NULL, 0, 'e', 's', dist_matrix->rawData());
+    const IncidenceMatrix &features =
+            (metric == Metric::L1 || metric == Metric::L2)?
+            incidence_matrix : weighted_incidence_matrix;
 
-    if(plain_tree == NULL)
-        throw std::runtime_error("Fail in clustering process.");
+    // Use the transposed incidence matrix in case of constraint clustering.
+    IncidenceMatrix transposed;
+    if(type == ClusteringObject::CONSTRAINT)
+        transposed = features.transpose();
 
-    const int TREESIZE = inc_matrix->rows() - 1;
+    const IncidenceMatrix &inc_matrix =
+            (type == ClusteringObject::CONSTRAINT? transposed : features);
 
     vector<ClusterTree::CClusteringLibNode> formatted_data;
-    formatted_data.reserve(TREESIZE);
 
-    for(int i = 0; i < TREESIZE; ++i) {
-        auto &node = plain_tree[i];
-        formatted_data.emplace_back(node.left, node.right, node.distance);
+    evaluated_pairs_fraction = 1.0;
+
+    if(engine != ClusteringEngine::C_CLUSTERING_LIBRARY) {
+        if(inc_matrix.rows() < 2)
+            throw std::runtime_error("Fail in clustering process.");
+
+        SingleLinkage::Metric sl_metric;
+        switch(metric) {
+        case Clusterator::Metric::L1:
+        case Clusterator::Metric::WEIGHTED_L1:
+            sl_metric = SingleLinkage::Metric::L1;
+            break;
+
+        case Clusterator::Metric::L2:
+        case Clusterator::Metric::WEIGHTED_L2:
+            sl_metric = SingleLinkage::Metric::L2;
+            break;
+
+        default:
+            sl_metric = SingleLinkage::Metric::SHARED;
+            break;
+        }
+
+        #ifdef DEBUG
+        cout << "> Clustering by minimum spanning tree..." << endl;
+        #endif
+
+        SingleLinkage single_linkage(inc_matrix, sl_metric, min_sharing);
+        if(engine == ClusteringEngine::MINHASH_LSH)
+            single_linkage.setMinHash(lsh_bands, lsh_rows_per_band);
+
+        formatted_data = single_linkage.cluster();
+        evaluated_pairs_fraction = single_linkage.getEvaluatedPairsFraction();
+
+        #ifdef DEBUG
+        cout << "> Borůvka rounds: " << single_linkage.getNumRounds()
+             << "\n> Fraction of pairs evaluated: " << evaluated_pairs_fraction
+             << endl;
+        #endif
     }
+    else {
+        #ifdef DEBUG
+        switch(metric) {
+        case Clusterator::Metric::L1:
+            cout << "> Computing L1...";
+            break;
+        case Clusterator::Metric::L2:
+            cout << "> Computing L2...";
+            break;
+        case Clusterator::Metric::WEIGHTED_L1:
+            cout << "> Computing weighted L1...";
+            break;
+        case Clusterator::Metric::WEIGHTED_L2:
+            cout << "> Computing weighted L2...";
+            break;
+        default:
+            break;
+        }
+        cout << endl;
+        #endif
+
+        switch(metric) {
+        case Clusterator::Metric::L1:
+        case Clusterator::Metric::WEIGHTED_L1:
+            computeL1Distance(inc_matrix);
+            break;
+
+        case Clusterator::Metric::L2:
+        case Clusterator::Metric::WEIGHTED_L2:
+            computeL2Distance(inc_matrix);
+            break;
+
+        default:
+            break;
+        }
+
+        #ifdef DEBUG
+        cout << "> Clustering..." << endl;
+        #endif
+
+        DistanceMatrix *dist_matrix;
 
-    delete[] plain_tree;
+        if(metric == Metric::SHARED) {
+            buildSharingMatrices();
+            if(type == ClusteringObject::VARIABLE)
+                dist_matrix = &variables_distance;
+            else
+                dist_matrix = &constraints_distance;
+        }
+        else
+            dist_matrix = &metric_distance;
+
+        Node* plain_tree = treecluster((int)inc_matrix.rows(), (int)inc_matrix.cols(),
+                                       NULL, NULL, NULL, 0, 'e', 's', dist_matrix->rawData());
+
+        if(plain_tree == NULL)
+            throw std::runtime_error("Fail in clustering process.");
+
+        const int TREESIZE = inc_matrix.rows() - 1;
+        formatted_data.reserve(TREESIZE);
+
+        for(int i = 0; i < TREESIZE; ++i) {
+            auto &node = plain_tree[i];
+            formatted_data.emplace_back(node.left, node.right, node.distance);
+        }
+
+        delete[] plain_tree;
+    }
 
     std::shared_ptr<ClusterTree> tree(
             new ClusterTree(formatted_data,
@@ -412,14 +640,6 @@ std::shared_ptr<ClusterTree> Clusterator::hierarchicalClustering(
     cout << "\n\n>> Tree:\n" << *tree << endl;
     #endif
 
-    // Come back to the regular matrix.
-    if(type == ClusteringObject::CONSTRAINT) {
-        if(metric == Metric::L1 || metric == Metric::L2)
-            incidence_matrix.transposeInPlace();
-        else
-            weighted_incidence_matrix.transposeInPlace();
-    }
-
     #ifdef DEBUG
     cout << "--------------------------------\n" << endl;
     #endif
@@ -430,47 +650,56 @@ std::shared_ptr<ClusterTree> Clusterator::hierarchicalClustering(
 //-----------------------------[ L1 distance ]--------------------------------//
 
 void Clusterator::computeL1Distance(const IncidenceMatrix &matrix) {
-    typedef decltype(matrix.rows()) IndexType;
-    const auto N = matrix.rows();
-    metric_distance.resize(N);
-
-    // This is not the best but helps a little. We must find an algebraic
-    // form as in L2 to used the Eigen parallel machinery.
-    for(IndexType i = 0; i < N - 1; ++i) {
-        const auto &row = matrix.row(i);
-
-        #ifdef _OPENMP
-        #pragma omp parallel for shared(row)
-        #endif
-        for(IndexType j = i + 1; j < N; ++j) {
-            metric_distance(i, j) = (row - matrix.row(j)).lpNorm<1>();
-        }
+    const long N = matrix.rows();
+    const long M = matrix.cols();
+    allocateDistanceMatrix(metric_distance, N, "metric");
+
+    // Dense enough features are expanded and compared with the vectorized
+    // kernel; otherwise, the sparse one is cheaper. We only expand
+    // when the copy is not larger than the distance matrix itself.
+    if(M > 0 && M <= N &&
+       matrix.nonZeros() >= L1_DENSE_MIN_DENSITY * (double)N * (double)M) {
+        const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+            dense(matrix);
+        l1DistanceDense(dense.data(), N, M, metric_distance);
+    }
+    else {
+        l1DistanceSparse(matrix, metric_distance);
     }
 }
 
 //-----------------------------[ L2 distance ]--------------------------------//
 
 void Clusterator::computeL2Distance(const IncidenceMatrix &matrix) {
-    typedef decltype(matrix.rows()) IndexType;
-
-    // First, compute the distances.
-    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> XX, D;
-    const auto N = matrix.rows();
-
-    XX.resize(N, 1);
-    D.resize(N, N);
+    typedef IncidenceMatrix::Index IndexType;
+    const IndexType N = matrix.rows();
+
+    // First, the squared norms of the rows and their inner products.
+    Eigen::VectorXd XX(N);
+    for(IndexType i = 0; i < N; ++i) {
+        double sum = 0.0;
+        for(IncidenceMatrix::InnerIterator it(matrix, i); it; ++it)
+            sum += it.value() * it.value();
+        XX(i) = sum;
+    }
 
-    XX = matrix.array().square().rowwise().sum();
-    D.noalias() = XX.replicate(1, N) + XX.transpose().replicate(N, 1);
-    D -= 2 * matrix * matrix.transpose();
-    D = D.cwiseSqrt();
+    const IncidenceMatrix products(matrix * matrix.transpose());
 
-    // After that, copy to the final destination.
-    metric_distance.resize(N);
+    // After that, write the distances on the final destination. Rows without
+    // columns in common have inner product zero.
+    allocateDistanceMatrix(metric_distance, N, "metric");
 
-    for(IndexType i = 0; i < D.rows(); ++i)
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 16)
+    #endif
+    for(IndexType i = 0; i < N; ++i) {
         for(IndexType j = 0; j < i + 1; ++j)
-            metric_distance(i, j) = D(i, j);
+            metric_distance(i, j) = sqrt(XX(i) + XX(j));
+
+        for(IncidenceMatrix::InnerIterator it(products, i); it && it.index() <= i; ++it)
+            metric_distance(i, it.index()) =
+                    sqrt(max(0.0, XX(i) + XX(it.index()) - 2 * it.value()));
+    }
 }
 
 } //endnamaspace
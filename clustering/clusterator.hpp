@@ -39,6 +39,7 @@
 // So, we just deactivate these flags here.
 #include "pragma_diagnostic_ignored_header.hpp"
 #include "Eigen/Dense"
+#include "Eigen/SparseCore"
 #include <cstring>
 #include <ilcplex/ilocplex.h>
 #include "pragma_diagnostic_ignored_footer.hpp"
@@ -106,6 +107,36 @@ class Clusterator {
             VARIABLE,   ///< Do variable clustering.
             CONSTRAINT  ///< Do constraint clustering.
         };
+
+        /// The algorithm used to build the single-linkage tree.
+        enum class ClusteringEngine {
+            /// The C clustering library (treecluster). It needs the full
+            /// distance matrix, i.e., O(n^2) memory and time.
+            C_CLUSTERING_LIBRARY,
+
+            /// Minimum spanning tree over the feature matrix (see
+            /// SingleLinkage). It only uses O(n + nnz) memory and builds
+            /// the same tree as the C clustering library.
+            MINIMUM_SPANNING_TREE,
+
+            /// Approximate minimum spanning tree for very large models: only
+            /// the pairs of objects found by MinHash/LSH over their
+            /// incidence sets have the distances computed (see
+            /// setMinHashParameters()). The other pairs are taken as having
+            /// nothing in common.
+            MINHASH_LSH
+        };
+
+        /// Format of the files written by buildIncidenceMatrices().
+        enum class OutputFormat {
+            /// Dense text matrices ("*.dat").
+            ASCII,
+
+            /// Binary, memory-mappable files ("*.bin", see MatrixFile).
+            /// The incidence matrices are sparse, the sharing matrices are
+            /// packed triangles. They can be reloaded by loadMatrices().
+            BINARY
+        };
         //@}
 
     public:
@@ -124,17 +155,35 @@ class Clusterator {
         /** Brief Build the incidence matrices from CPLEX objects. These
          * matrices are used as feature matrices to compute the
          * distance/dissimilarity between the variables or constraints
-         * according to user choice. This method also computes the
-         * shared_contraints_var_distances matrix.
+         * according to user choice. The sharing distance matrices are
+         * built only when written on files or required by the clustering.
          *
          * \param variables MIP variables
          * \param constraints MIP constraints
          * \param output_file_preffix write the matrices on files with this
          * preffix. If empty, the matrices are not written.x
+         * \param min_sharing pairs of objects sharing fewer than min_sharing
+         * constraints (variables) are taken as sharing nothing: their counts
+         * are stored as zero. Note that the sharing matrices are still dense
+         * triangles, so this does not reduce their memory.
          */
         void buildIncidenceMatrices(const IloNumVarArray &variables,
                                     const IloRangeArray &constraints,
-                                    std::string output_file_preffix = std::string());
+                                    std::string output_file_preffix = std::string(),
+                                    const double min_sharing = 1.0);
+
+        /** \brief Reload the matrices written by buildIncidenceMatrices()
+         * in OutputFormat::BINARY, instead of building them again. The
+         * sharing matrices are loaded if their files exist, and they are
+         * memory-mapped (privately) from the files.
+         * \param file_prefix the prefix given to buildIncidenceMatrices().
+         */
+        void loadMatrices(const std::string &file_prefix);
+
+        /// Set the format of the files written by buildIncidenceMatrices().
+        void setOutputFormat(const OutputFormat format) {
+            output_format = format;
+        }
         //@}
 
         /** Clustering methods */
@@ -143,10 +192,46 @@ class Clusterator {
          * between variables or constraints.
          * \param type which type of object is to be clustered.
          * \param metric used to build the distance matrix.
+         * \param engine the algorithm used to build the tree.
          * \return a tree representing the clustering.
          */
         std::shared_ptr<ClusterTree> hierarchicalClustering(const ClusteringObject type,
-                                                            const Metric metric);
+                                const Metric metric,
+                                const ClusteringEngine engine =
+                                        ClusteringEngine::MINIMUM_SPANNING_TREE);
+        //@}
+
+        /** Memory management */
+        //@{
+        /** \brief Allocate the distance matrices, from now on, on
+         * memory-mapped files instead of RAM. This is useful when the
+         * matrices do not fit in memory. The files are created as
+         * file_prefix + "_<matrix>.dist" and unlinked right after mapping.
+         * \param file_prefix the files' prefix. If empty, the matrices go
+         *        back to the heap.
+         */
+        void mapDistanceMatrices(const std::string &file_prefix);
+        //@}
+
+        /** Approximate clustering */
+        //@{
+        /** \brief Set the recall/speed trade-off of the
+         * ClusteringEngine::MINHASH_LSH engine. Two objects have their
+         * distance computed if their MinHash signatures agree on all
+         * rows_per_band values of at least one of the bands. More bands
+         * evaluate more pairs (better recall); more rows per band evaluate
+         * fewer pairs (faster).
+         * \param bands number of LSH bands.
+         * \param rows_per_band number of MinHash values per band.
+         */
+        void setMinHashParameters(const int bands, const int rows_per_band);
+
+        /// Returns the fraction of all pairs of objects that had their
+        /// distances computed in the last clustering (1.0 for the exact
+        /// engines).
+        double getEvaluatedPairsFraction() const {
+            return evaluated_pairs_fraction;
+        }
         //@}
 
     private:
@@ -156,19 +241,21 @@ class Clusterator {
     protected:
         /** Type definitions */
         //@{
-        /// A short name for the incidence matrices.
-        typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-            IncidenceMatrix;
+        /// A short name for the incidence matrices. Real MIPs have only a
+        /// handful of non-zeros per row, so the matrices are stored in
+        /// compressed sparse row form (inner indices sorted).
+        typedef Eigen::SparseMatrix<double, Eigen::RowMajor> IncidenceMatrix;
 
-        /// A short name for distance matrices.
+        /// A short name for distance matrices. Note that the C clustering
+        /// library only takes doubles.
         typedef PlainRaggedMatrix<double, IloInt> DistanceMatrix;
         //@}
 
         /** The matrices */
         //@{
         /// This matrix holds the constraint coefficients. It can see as the
-        /// transpose of the original constraint matrix. We store it using
-        /// column major scheme.
+        /// transpose of the original constraint matrix. We store it in sparse
+        /// row major scheme (one row per variable).
         IncidenceMatrix weighted_incidence_matrix;
 
         /// The same as weighted_incidence_matrix, but it is a binary matrix
@@ -219,24 +306,69 @@ class Clusterator {
 
         /// Holds the constraint names.
         std::vector<std::string> constraint_names;
+
+        /// If not empty, the distance matrices are mapped on files with
+        /// this prefix.
+        std::string distance_file_prefix;
+
+        /// Minimum number of sharings to be accounted (see
+        /// buildIncidenceMatrices()).
+        double min_sharing;
+
+        /// Indicates if variables_distance and constraints_distance were
+        /// built. They are built only on demand, since they take O(n^2)
+        /// memory.
+        bool sharing_matrices_built;
+
+        /// Number of LSH bands for ClusteringEngine::MINHASH_LSH.
+        int lsh_bands;
+
+        /// Number of MinHash values per LSH band.
+        int lsh_rows_per_band;
+
+        /// Fraction of the pairs evaluated in the last clustering.
+        double evaluated_pairs_fraction;
+
+        /// Format of the output files.
+        OutputFormat output_format;
         //@}
 
     protected:
         /** Helper functions */
         //@{
+        /// Allocate (and zero) a distance matrix, on the heap or on a
+        /// memory-mapped file, according to distance_file_prefix.
+        /// \param matrix to be allocated.
+        /// \param size the matrix's dimension.
+        /// \param name used to build the file name.
+        void allocateDistanceMatrix(DistanceMatrix &matrix, const IloInt size,
+                                    const std::string &name);
+
+        /// Build variables_distance and constraints_distance from the
+        /// incidence matrices, if not built yet.
+        void buildSharingMatrices();
+
+        /// Write all matrices in OutputFormat::BINARY.
+        /// \param file_prefix the files' prefix.
+        void writeBinaryMatrices(const std::string &file_prefix);
+
         /// Compute the L1 norm distance, aka, Manhattan distance. The results
-        /// are written on Clusterator::distance.
-        /// <em>THIS METHOD IS VERY TIME CONSUMING</em>.
-        /// \todo Find an algebraic form to compute L1 to used the
-        ///       Eigen parallel machinery.
+        /// are written on Clusterator::distance. Sparse features go to the
+        /// scatter/gather kernel l1DistanceSparse(), which scatters each row
+        /// in a dense buffer and gathers the other rows against it; dense
+        /// enough ones go to the vectorized kernel. Both are tiled (see
+        /// distance_kernels.hpp).
+        /// <em>THIS METHOD IS VERY TIME CONSUMING</em> (quadratic in the
+        /// number of rows).
         /// \param matrix of features to be used to compute the distances.
         void computeL1Distance(const IncidenceMatrix &matrix);
 
 
         /// Compute the L2 norm distance, aka, Euclidean distance. The results
-        /// are written on Clusterator::distance. This computation can take
-        /// a while due to its nature. This method uses the full advantages of
-        /// Eigen library, using as much cores as available in the system.
+        /// are written on Clusterator::distance. We use
+        /// ||a - b||^2 = ||a||^2 + ||b||^2 - 2<a, b>, where the inner
+        /// products come from the sparse product matrix * matrix^T. Only
+        /// rows sharing a column have a non-zero inner product.
         /// \param matrix of features to be used to compute the distances.
         void computeL2Distance(const IncidenceMatrix &matrix);
         //@}
@@ -0,0 +1,551 @@
+/******************************************************************************
+ * matrix_file.hpp: Binary files for the clustering matrices.
+ *
+ * Author: Carlos Eduardo de Andrade
+ *         <carlos.andrade@gatech.edu / ce.andrade@gmail.com>
+ *
+ * (c) Copyright 2015-2019
+ *     Industrial and Systems Engineering, Georgia Institute of Technology
+ *     All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by andrade
+ *  Last update: Oct 18, 2026 by andrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef MATRIX_FILE_HPP_
+#define MATRIX_FILE_HPP_
+
+#include "plain_ragged_matrix.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <unistd.h>
+
+namespace ce_andrade {
+
+/**
+ * \brief Matrix File
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * Binary files for the clustering matrices, made to be memory-mapped.
+ * All numbers are little-endian; values are IEEE-754 doubles. The file
+ * starts with a header of MatrixFile::ALIGNMENT bytes:
+ *
+ * | Offset | Type     | Field                                           |
+ * |--------|----------|-------------------------------------------------|
+ * | 0      | char[8]  | magic "BRKGAMTX"                                |
+ * | 8      | uint32   | version (1)                                     |
+ * | 12     | uint32   | kind (MatrixFile::Kind)                         |
+ * | 16     | uint64   | number of rows                                  |
+ * | 24     | uint64   | number of columns                               |
+ * | 32     | uint64   | number of values                                |
+ * | 40     | uint64   | offset of the names                             |
+ * | 48     | uint64   | size of the names, in bytes                     |
+ * | 56     | uint64   | offset of the row starts (sparse only)          |
+ * | 64     | uint64   | offset of the column indices (sparse only)      |
+ * | 72     | uint64   | offset of the values                            |
+ * | 80     | double   | parameter (min. sharing for sharing matrices)   |
+ *
+ * The sections start on multiples of MatrixFile::ALIGNMENT, so they can
+ * be mapped on hosts with pages up to 64 KiB:
+ * - names: the row names followed by the column names (sparse only),
+ *   each one terminated by '\0';
+ * - SPARSE: compressed rows, i.e., the triplets sorted by row, as rows + 1
+ *   uint64 row starts, and uint32 column indices and values for each
+ *   non-zero;
+ * - PACKED_TRIANGLE: the lower triangle with diagonal, row by row, as
+ *   PlainRaggedMatrix::packedData(). So, PlainRaggedMatrix::mapFile() maps
+ *   it straight from the file.
+ */
+class MatrixFile {
+    public:
+        /** \name Enumerations */
+        //@{
+        /// The type of matrix in the file.
+        enum class Kind : uint32_t {
+            SPARSE = 1,             ///< Sparse matrix in compressed rows.
+            PACKED_TRIANGLE = 2     ///< Symmetric matrix, packed lower triangle.
+        };
+        //@}
+
+        /** \name Constants */
+        //@{
+        /// Alignment of the sections, in bytes. It is a multiple of the
+        /// page size of the usual hosts (4 KiB, 16 KiB, and 64 KiB).
+        static const std::size_t ALIGNMENT = 65536;
+
+        /// Number of elements converted at once, when the values are not
+        /// written or read straight.
+        static const std::size_t BUFFER_SIZE = 4096;
+
+        /// Current version of the format.
+        static const uint32_t VERSION = 1;
+        //@}
+
+        /// The header of a file.
+        struct Header {
+            Kind kind;
+            uint64_t rows;
+            uint64_t cols;
+            uint64_t num_values;
+            uint64_t names_offset;
+            uint64_t names_bytes;
+            uint64_t outer_offset;
+            uint64_t inner_offset;
+            uint64_t values_offset;
+            double parameter;
+        };
+
+    public:
+        /** \name Writing */
+        //@{
+        /** \brief Write a sparse matrix (Eigen::SparseMatrix, row-major).
+         * \param file_name the file.
+         * \param matrix the matrix.
+         * \param row_names the name of each row.
+         * \param col_names the name of each column.
+         */
+        template <typename SparseMatrix>
+        static void writeSparse(const std::string &file_name,
+                                const SparseMatrix &matrix,
+                                const std::vector<std::string> &row_names,
+                                const std::vector<std::string> &col_names);
+
+        /** \brief Write the packed triangle of a symmetric matrix.
+         * \param file_name the file.
+         * \param matrix the matrix.
+         * \param names the name of each row/column.
+         * \param parameter stored in the header.
+         */
+        template <typename DataType, typename IndexType>
+        static void writePackedTriangle(const std::string &file_name,
+                                const PlainRaggedMatrix<DataType, IndexType> &matrix,
+                                const std::vector<std::string> &names,
+                                const double parameter = 0.0);
+        //@}
+
+        /** \name Reading */
+        //@{
+        /// Read and check the header of a file.
+        static Header readHeader(const std::string &file_name);
+
+        /** \brief Read a sparse matrix.
+         * \param file_name the file.
+         * \param matrix the matrix (Eigen::SparseMatrix, row-major).
+         * \param row_names the name of each row.
+         * \param col_names the name of each column.
+         */
+        template <typename SparseMatrix>
+        static void readSparse(const std::string &file_name, SparseMatrix &matrix,
+                               std::vector<std::string> &row_names,
+                               std::vector<std::string> &col_names);
+
+        /** \brief Read a packed triangle.
+         * \param file_name the file.
+         * \param matrix the matrix.
+         * \param names the name of each row/column.
+         * \param map if true, the matrix is mapped from the file (private
+         *        mapping), instead of copied to the heap. Only done on
+         *        little-endian hosts.
+         * \return the parameter stored in the header.
+         */
+        template <typename DataType, typename IndexType>
+        static double readPackedTriangle(const std::string &file_name,
+                                PlainRaggedMatrix<DataType, IndexType> &matrix,
+                                std::vector<std::string> &names,
+                                const bool map = true);
+        //@}
+
+    protected:
+        /** Helper functions */
+        //@{
+        /// Indicates if this host is little-endian.
+        static bool littleEndianHost() {
+            const uint32_t one = 1;
+            unsigned char first;
+            std::memcpy(&first, &one, 1);
+            return first == 1;
+        }
+
+        /// Reverse the bytes of each element (big-endian hosts only).
+        template <typename T>
+        static void swapBytes(T *data, const std::size_t size) {
+            for(std::size_t i = 0; i < size; ++i) {
+                unsigned char *bytes = reinterpret_cast<unsigned char*>(data + i);
+                std::reverse(bytes, bytes + sizeof(T));
+            }
+        }
+
+        /// Round up to the next multiple of ALIGNMENT.
+        static uint64_t align(const uint64_t offset) {
+            return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        }
+
+        /// Page size of this host, in bytes.
+        static uint64_t hostPageSize() {
+            const long page_size = sysconf(_SC_PAGESIZE);
+            return (page_size > 0)? (uint64_t)page_size : (uint64_t)ALIGNMENT;
+        }
+
+        /// Write an array in little-endian.
+        template <typename T>
+        static void writeArray(std::ofstream &file, const T *data, const std::size_t size);
+
+        /// Read an array in little-endian.
+        template <typename T>
+        static void readArray(std::ifstream &file, T *data, const std::size_t size);
+
+        /// Pad the file with zeros up to offset.
+        static void padTo(std::ofstream &file, const uint64_t offset) {
+            static const char zeros[ALIGNMENT] = {};
+            uint64_t position = (uint64_t)file.tellp();
+            while(position < offset) {
+                const uint64_t chunk = std::min(offset - position, (uint64_t)ALIGNMENT);
+                file.write(zeros, (std::streamsize)chunk);
+                position += chunk;
+            }
+        }
+
+        /// Size of the names once written.
+        static uint64_t namesBytes(const std::vector<std::string> &names) {
+            uint64_t bytes = 0;
+            for(const auto &name : names)
+                bytes += name.size() + 1;
+            return bytes;
+        }
+
+        /// Write the header.
+        static void writeHeader(std::ofstream &file, const Header &header);
+
+        /// Write the names, each one terminated by '\0'.
+        static void writeNames(std::ofstream &file, const std::vector<std::string> &names) {
+            for(const auto &name : names)
+                file.write(name.c_str(), (std::streamsize)name.size() + 1);
+        }
+
+        /// Read num_names names from the current position.
+        static void readNames(std::ifstream &file, const uint64_t num_names,
+                              std::vector<std::string> &names) {
+            names.clear();
+            names.reserve(num_names);
+            for(uint64_t i = 0; i < num_names; ++i) {
+                std::string name;
+                std::getline(file, name, '\0');
+                names.push_back(name);
+            }
+        }
+
+        /// Open a file for writing, throwing on failure.
+        static void openOutput(std::ofstream &file, const std::string &file_name) {
+            file.open(file_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+            if(!file)
+                throw std::runtime_error(std::string("Cannot open file ") + file_name);
+        }
+
+        /// Open a file for reading and load its header.
+        static Header openInput(std::ifstream &file, const std::string &file_name,
+                                const Kind kind);
+        //@}
+};
+
+//-----------------------------[ Array I/O ]----------------------------------//
+
+template <typename T>
+void MatrixFile::writeArray(std::ofstream &file, const T *data, const std::size_t size) {
+    if(littleEndianHost()) {
+        file.write(reinterpret_cast<const char*>(data), (std::streamsize)(size * sizeof(T)));
+        return;
+    }
+
+    std::vector<T> buffer;
+    for(std::size_t begin = 0; begin < size; begin += BUFFER_SIZE) {
+        buffer.assign(data + begin, data + std::min(begin + BUFFER_SIZE, size));
+        swapBytes(buffer.data(), buffer.size());
+        file.write(reinterpret_cast<const char*>(buffer.data()),
+                   (std::streamsize)(buffer.size() * sizeof(T)));
+    }
+}
+
+template <typename T>
+void MatrixFile::readArray(std::ifstream &file, T *data, const std::size_t size) {
+    file.read(reinterpret_cast<char*>(data), (std::streamsize)(size * sizeof(T)));
+    if(!littleEndianHost())
+        swapBytes(data, size);
+}
+
+//-------------------------------[ Header ]-----------------------------------//
+
+inline void MatrixFile::writeHeader(std::ofstream &file, const Header &header) {
+    const uint32_t version_kind[2] = {VERSION, (uint32_t)header.kind};
+    const uint64_t fields[8] = {header.rows, header.cols, header.num_values,
+                                header.names_offset, header.names_bytes,
+                                header.outer_offset, header.inner_offset,
+                                header.values_offset};
+
+    file.seekp(0);
+    file.write("BRKGAMTX", 8);
+    writeArray(file, version_kind, 2);
+    writeArray(file, fields, 8);
+    writeArray(file, &header.parameter, 1);
+}
+
+inline MatrixFile::Header MatrixFile::readHeader(const std::string &file_name) {
+    std::ifstream file(file_name.c_str(), std::ios::in | std::ios::binary);
+    if(!file)
+        throw std::runtime_error(std::string("Cannot open file ") + file_name);
+
+    char magic[8];
+    uint32_t version_kind[2];
+    uint64_t fields[8];
+    Header header;
+
+    file.read(magic, 8);
+    readArray(file, version_kind, 2);
+    readArray(file, fields, 8);
+    readArray(file, &header.parameter, 1);
+
+    if(!file || std::memcmp(magic, "BRKGAMTX", 8) != 0)
+        throw std::runtime_error(std::string("Not a matrix file: ") + file_name);
+
+    if(version_kind[0] != VERSION)
+        throw std::runtime_error(std::string("Unsupported matrix file version: ") + file_name);
+
+    header.kind = (Kind)version_kind[1];
+    header.rows = fields[0];
+    header.cols = fields[1];
+    header.num_values = fields[2];
+    header.names_offset = fields[3];
+    header.names_bytes = fields[4];
+    header.outer_offset = fields[5];
+    header.inner_offset = fields[6];
+    header.values_offset = fields[7];
+
+    file.seekg(0, std::ios::end);
+    const uint64_t file_size = (uint64_t)file.tellg();
+    const uint64_t values_bytes = header.num_values * sizeof(double);
+    if(header.values_offset + values_bytes > file_size ||
+       header.names_offset + header.names_bytes > file_size)
+        throw std::runtime_error(std::string("Truncated matrix file: ") + file_name);
+
+    return header;
+}
+
+inline MatrixFile::Header MatrixFile::openInput(std::ifstream &file,
+                                                const std::string &file_name,
+                                                const Kind kind) {
+    const Header header = readHeader(file_name);
+    if(header.kind != kind)
+        throw std::runtime_error(std::string("Unexpected matrix kind in file ") + file_name);
+
+    file.open(file_name.c_str(), std::ios::in | std::ios::binary);
+    if(!file)
+        throw std::runtime_error(std::string("Cannot open file ") + file_name);
+    return header;
+}
+
+//---------------------------[ Sparse matrices ]------------------------------//
+
+template <typename SparseMatrix>
+void MatrixFile::writeSparse(const std::string &file_name, const SparseMatrix &matrix,
+                             const std::vector<std::string> &row_names,
+                             const std::vector<std::string> &col_names) {
+    typedef typename SparseMatrix::InnerIterator InnerIterator;
+
+    Header header;
+    header.kind = Kind::SPARSE;
+    header.rows = (uint64_t)matrix.rows();
+    header.cols = (uint64_t)matrix.cols();
+    header.num_values = (uint64_t)matrix.nonZeros();
+    header.names_offset = ALIGNMENT;
+    header.names_bytes = namesBytes(row_names) + namesBytes(col_names);
+    header.outer_offset = align(header.names_offset + header.names_bytes);
+    header.inner_offset = align(header.outer_offset +
+                                    (header.rows + 1) * sizeof(uint64_t));
+    header.values_offset = align(header.inner_offset +
+                                     header.num_values * sizeof(uint32_t));
+    header.parameter = 0.0;
+
+    std::ofstream file;
+    openOutput(file, file_name);
+
+    writeHeader(file, header);
+
+    padTo(file, header.names_offset);
+    writeNames(file, row_names);
+    writeNames(file, col_names);
+
+    // The matrix may not be compressed. So, we go through the iterators.
+    std::vector<uint64_t> outer(header.rows + 1, 0);
+    std::vector<uint32_t> inner;
+    std::vector<double> values;
+    inner.reserve(header.num_values);
+    values.reserve(header.num_values);
+
+    for(typename SparseMatrix::Index i = 0; i < matrix.rows(); ++i) {
+        for(InnerIterator it(matrix, i); it; ++it) {
+            inner.push_back((uint32_t)it.index());
+            values.push_back(it.value());
+        }
+        outer[i + 1] = inner.size();
+    }
+
+    padTo(file, header.outer_offset);
+    writeArray(file, outer.data(), outer.size());
+    padTo(file, header.inner_offset);
+    writeArray(file, inner.data(), inner.size());
+    padTo(file, header.values_offset);
+    writeArray(file, values.data(), values.size());
+
+    if(!file)
+        throw std::runtime_error(std::string("Cannot write file ") + file_name);
+}
+
+template <typename SparseMatrix>
+void MatrixFile::readSparse(const std::string &file_name, SparseMatrix &matrix,
+                            std::vector<std::string> &row_names,
+                            std::vector<std::string> &col_names) {
+    typedef typename SparseMatrix::Index Index;
+    typedef typename SparseMatrix::Scalar Scalar;
+
+    std::ifstream file;
+    const Header header = openInput(file, file_name, Kind::SPARSE);
+
+    file.seekg((std::streamoff)header.names_offset);
+    readNames(file, header.rows, row_names);
+    readNames(file, header.cols, col_names);
+
+    std::vector<uint64_t> outer(header.rows + 1);
+    std::vector<uint32_t> inner(header.num_values);
+    std::vector<double> values(header.num_values);
+
+    file.seekg((std::streamoff)header.outer_offset);
+    readArray(file, outer.data(), outer.size());
+    file.seekg((std::streamoff)header.inner_offset);
+    readArray(file, inner.data(), inner.size());
+    file.seekg((std::streamoff)header.values_offset);
+    readArray(file, values.data(), values.size());
+
+    if(!file || outer.back() != header.num_values)
+        throw std::runtime_error(std::string("Cannot read file ") + file_name);
+
+    matrix.resize((Index)header.rows, (Index)header.cols);
+    matrix.resizeNonZeros((Index)header.num_values);
+    std::copy(outer.begin(), outer.end(), matrix.outerIndexPtr());
+    std::copy(inner.begin(), inner.end(), matrix.innerIndexPtr());
+    std::transform(values.begin(), values.end(), matrix.valuePtr(),
+                   [](const double value) { return (Scalar)value; });
+}
+
+//---------------------------[ Packed triangles ]-----------------------------//
+
+template <typename DataType, typename IndexType>
+void MatrixFile::writePackedTriangle(const std::string &file_name,
+                            const PlainRaggedMatrix<DataType, IndexType> &matrix,
+                            const std::vector<std::string> &names,
+                            const double parameter) {
+    Header header;
+    header.kind = Kind::PACKED_TRIANGLE;
+    header.rows = (uint64_t)matrix.getSize();
+    header.cols = header.rows;
+    header.num_values = matrix.numElements();
+    header.names_offset = ALIGNMENT;
+    header.names_bytes = namesBytes(names);
+    header.outer_offset = 0;
+    header.inner_offset = 0;
+    header.values_offset = align(header.names_offset + header.names_bytes);
+    header.parameter = parameter;
+
+    std::ofstream file;
+    openOutput(file, file_name);
+
+    writeHeader(file, header);
+
+    padTo(file, header.names_offset);
+    writeNames(file, names);
+
+    padTo(file, header.values_offset);
+    if(std::is_same<DataType, double>::value) {
+        writeArray(file, reinterpret_cast<const double*>(matrix.packedData()),
+                   header.num_values);
+    }
+    else {
+        const DataType *packed = matrix.packedData();
+        std::vector<double> buffer;
+        for(std::size_t begin = 0; begin < header.num_values; begin += BUFFER_SIZE) {
+            const std::size_t end = std::min<std::size_t>(begin + BUFFER_SIZE, header.num_values);
+            buffer.assign(packed + begin, packed + end);
+            writeArray(file, buffer.data(), buffer.size());
+        }
+    }
+
+    if(!file)
+        throw std::runtime_error(std::string("Cannot write file ") + file_name);
+}
+
+template <typename DataType, typename IndexType>
+double MatrixFile::readPackedTriangle(const std::string &file_name,
+                            PlainRaggedMatrix<DataType, IndexType> &matrix,
+                            std::vector<std::string> &names,
+                            const bool map) {
+    std::ifstream file;
+    const Header header = openInput(file, file_name, Kind::PACKED_TRIANGLE);
+
+    if(header.rows != header.cols ||
+       header.num_values != header.rows * (header.rows + 1) / 2)
+        throw std::runtime_error(std::string("Inconsistent packed triangle: ") + file_name);
+
+    file.seekg((std::streamoff)header.names_offset);
+    readNames(file, header.rows, names);
+
+    // Files written with a smaller alignment are copied if their values
+    // are not on a page boundary of this host.
+    if(map && littleEndianHost() && std::is_same<DataType, double>::value &&
+       header.values_offset % hostPageSize() == 0) {
+        matrix.mapFile((IndexType)header.rows, file_name,
+                       (std::size_t)header.values_offset);
+    }
+    else {
+        matrix.resize((IndexType)header.rows);
+        DataType *packed = matrix.packedData();
+        std::vector<double> buffer;
+        file.seekg((std::streamoff)header.values_offset);
+        for(std::size_t begin = 0; begin < header.num_values; begin += BUFFER_SIZE) {
+            const std::size_t end = std::min<std::size_t>(begin + BUFFER_SIZE, header.num_values);
+            buffer.resize(end - begin);
+            readArray(file, buffer.data(), buffer.size());
+            std::copy(buffer.begin(), buffer.end(), packed + begin);
+        }
+    }
+
+    if(!file)
+        throw std::runtime_error(std::string("Cannot read file ") + file_name);
+
+    return header.parameter;
+}
+
+} //endnamaspace
+
+#endif //MATRIX_FILE_HPP_
@@ -9,7 +9,7 @@
  *     All Rights Reserved.
  *
  *  Created on : May 24, 2015 by andrade
- *  Last update: Jun 17, 2015 by andrade
+ *  Last update: Oct 18, 2026 by andrade
  *
  * This code is released under LICENSE.md.
  *
@@ -32,6 +32,15 @@
 #include <iostream>
 #include <new>
 #include <algorithm>
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <cstdlib>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 namespace ce_andrade {
 
@@ -44,9 +53,15 @@ namespace ce_andrade {
  * This class represents a plain ragged matrix used in the clustering
  * algorithm. This is bottom-left triangular symmetric matrix.
  *
+ * The triangle (diagonal included) is packed row by row in a single
+ * aligned block, either on the heap or on a memory-mapped file (so, large
+ * matrices can spill to disk). A small array of row pointers over this
+ * block gives the "DataType**" view used by the C clustering library.
+ * DataType is usually double or float.
+ *
  * \note
  *  -# We DO NOT CHECK types or use traits in this template;
- *  -# DataType must have a simple constructor;
+ *  -# DataType must be a plain type (zero bytes mean zero value);
  *  -# IndexType must be a countable type admitting initialization from zero,
  *     pre-increment operator, and less_than operator. Usually, IndexType
  *     will be a integer type.
@@ -54,25 +69,30 @@ namespace ce_andrade {
 template <typename DataType, typename IndexType>
 class PlainRaggedMatrix {
     public:
+        /// Alignment of the packed data, in bytes (a cache line).
+        static const std::size_t ALIGNMENT = 64;
+
         /** \name Constructor and Destructor */
         //@{
         /// Default constructor.
-        PlainRaggedMatrix(): size(0), data(nullptr) {}
+        PlainRaggedMatrix():
+            size(0), data(nullptr), packed(nullptr), mapped_bytes(0) {}
 
         /** \brief Build constructor.
          * \param _size the matrix's dimension.
          */
-        explicit PlainRaggedMatrix(const IndexType _size): size(0), data(nullptr) {
+        explicit PlainRaggedMatrix(const IndexType _size):
+            size(0), data(nullptr), packed(nullptr), mapped_bytes(0) {
             resize(_size);
         }
 
-        /** \brief Copy constructor
+        /** \brief Copy constructor. The copy always lives on the heap.
          * \param other the matrix to be copied.
          */
-        PlainRaggedMatrix(const PlainRaggedMatrix& other): size(0), data(nullptr) {
+        PlainRaggedMatrix(const PlainRaggedMatrix& other):
+            size(0), data(nullptr), packed(nullptr), mapped_bytes(0) {
             resize(other.size);
-            for(IndexType i = 0; i < size; ++i)
-                std::copy(other.data[i], other.data[i] + (i + 1), data[i]);
+            std::copy(other.packed, other.packed + numElements(), packed);
         }
 
         /** \brief Destructor. */
@@ -83,18 +103,99 @@ class PlainRaggedMatrix {
 
         /** \name Re-dimensioning */
         //@{
-        /** Resize the matrix.
+        /** Resize the matrix on the heap. All elements are zeroed.
          * \param _size the new dimensions.
          */
         void resize(const IndexType _size) {
             deallocate();
-            data = new DataType*[_size];
 
-            for(IndexType i = 0; i < _size; ++i) {
-                data[i] = new DataType[i + 1];
-                std::fill_n(data[i], i + 1, DataType());
+            const std::size_t bytes = std::max(packedBytes(_size), ALIGNMENT);
+            void *memory = nullptr;
+            if(posix_memalign(&memory, ALIGNMENT, bytes) != 0)
+                throw std::bad_alloc();
+
+            packed = static_cast<DataType*>(memory);
+            std::memset(packed, 0, bytes);
+            buildRows(_size);
+        }
+
+        /** Resize the matrix on a memory-mapped file. The file is created
+         * (or truncated) with the size of the packed triangle, so all
+         * elements are zeroed. Pages not in use are written back to the
+         * file by the OS, instead of taking RAM.
+         * \param _size the new dimensions.
+         * \param file_name the backing file.
+         * \param keep_file if false, the file is unlinked right after
+         *        mapping (its space is released when the matrix is
+         *        deallocated).
+         */
+        void resizeMapped(const IndexType _size, const std::string &file_name,
+                          const bool keep_file = false) {
+            deallocate();
+
+            const std::size_t bytes = std::max(packedBytes(_size), ALIGNMENT);
+
+            const int fd = open(file_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if(fd < 0)
+                throw std::runtime_error(std::string("Cannot open file ") +
+                                         file_name + ": " + std::strerror(errno));
+
+            if(ftruncate(fd, (off_t)bytes) != 0) {
+                const int error = errno;
+                close(fd);
+                throw std::runtime_error(std::string("Cannot resize file ") +
+                                         file_name + ": " + std::strerror(error));
             }
-            size = _size;
+
+            void *memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                                MAP_SHARED, fd, 0);
+            const int error = errno;
+            close(fd);
+
+            if(!keep_file)
+                unlink(file_name.c_str());
+
+            if(memory == MAP_FAILED)
+                throw std::runtime_error(std::string("Cannot map file ") +
+                                         file_name + ": " + std::strerror(error));
+
+            // mmap() returns page aligned memory.
+            packed = static_cast<DataType*>(memory);
+            mapped_bytes = bytes;
+            buildRows(_size);
+        }
+
+        /** Map the matrix from an existing file holding a packed triangle
+         * (see packedData()). The mapping is private: the matrix can be
+         * modified, but the changes never reach the file.
+         * \param _size the dimensions.
+         * \param file_name the file.
+         * \param offset where the triangle starts in the file. It must be
+         *        a multiple of the page size.
+         */
+        void mapFile(const IndexType _size, const std::string &file_name,
+                     const std::size_t offset) {
+            deallocate();
+
+            const std::size_t bytes = std::max(packedBytes(_size), ALIGNMENT);
+
+            const int fd = open(file_name.c_str(), O_RDONLY);
+            if(fd < 0)
+                throw std::runtime_error(std::string("Cannot open file ") +
+                                         file_name + ": " + std::strerror(errno));
+
+            void *memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE, fd, (off_t)offset);
+            const int error = errno;
+            close(fd);
+
+            if(memory == MAP_FAILED)
+                throw std::runtime_error(std::string("Cannot map file ") +
+                                         file_name + ": " + std::strerror(error));
+
+            packed = static_cast<DataType*>(memory);
+            mapped_bytes = bytes;
+            buildRows(_size);
         }
         //@}
 
@@ -110,6 +211,16 @@ class PlainRaggedMatrix {
                 return data[col][row];
         }
 
+        /// Access the matrix element-wise. Note the m(x,y) = m(y,x).
+        /// \param row the row to be access.
+        /// \param col the column to be access.
+        const DataType& operator()(const IndexType row, const IndexType col) const {
+            if(col < row)
+                return data[row][col];
+            else
+                return data[col][row];
+        }
+
         /// Return a pointer to the raw data stored. Note that we may change
         /// the values stored there but not the pointer themselves. THIS IS
         /// A DANGEROUS METHOD. DO NOT MODIFY THE POINTERS (modify the data
@@ -118,10 +229,26 @@ class PlainRaggedMatrix {
             return data;
         }
 
+        /// Return the packed triangle, row by row: element (i, j), j <= i,
+        /// is at position i * (i + 1) / 2 + j.
+        inline DataType* packedData() const {
+            return packed;
+        }
+
+        /// Returns the number of elements in the packed triangle.
+        inline std::size_t numElements() const {
+            return packedElements(size);
+        }
+
         /// Returns the number of rows.
         inline IndexType getSize() const {
             return size;
         }
+
+        /// Returns true if the matrix lives on a memory-mapped file.
+        inline bool isMapped() const {
+            return mapped_bytes > 0;
+        }
         //@}
 
     private:
@@ -132,20 +259,48 @@ class PlainRaggedMatrix {
         /** The data */
         //@{
         IndexType size;     ///< The dimension size.
-        DataType** data;    ///< The data.
+        DataType** data;    ///< The row pointers (into packed).
+        DataType* packed;   ///< The packed triangle.
+        std::size_t mapped_bytes;   ///< Size of the mapping (0 if on heap).
         //@}
 
         /** Helper methods */
         //@{
-        /// Deallocate data.
-        void deallocate() {
-            if(data == nullptr)
-                return;
+        /// Number of elements of a packed triangle of dimension _size.
+        static std::size_t packedElements(const IndexType _size) {
+            return (std::size_t)_size * ((std::size_t)_size + 1) / 2;
+        }
+
+        /// Number of bytes of a packed triangle of dimension _size.
+        static std::size_t packedBytes(const IndexType _size) {
+            return packedElements(_size) * sizeof(DataType);
+        }
 
-            for(IndexType i = 0; i < size; ++i)
-                delete[] data[i];
+        /// Build the row pointers over the packed data.
+        void buildRows(const IndexType _size) {
+            data = new DataType*[_size];
+            std::size_t offset = 0;
+            for(IndexType i = 0; i < _size; ++i) {
+                data[i] = packed + offset;
+                offset += (std::size_t)i + 1;
+            }
+            size = _size;
+        }
 
+        /// Deallocate data.
+        void deallocate() {
             delete[] data;
+            data = nullptr;
+
+            if(packed != nullptr) {
+                if(mapped_bytes > 0)
+                    munmap(packed, mapped_bytes);
+                else
+                    free(packed);
+            }
+            packed = nullptr;
+            mapped_bytes = 0;
+            size = 0;
         }
         //@}
 
@@ -161,6 +316,9 @@ class PlainRaggedMatrix {
         }
 };
 
+template <typename DataType, typename IndexType>
+const std::size_t PlainRaggedMatrix<DataType, IndexType>::ALIGNMENT;
+
 } //endnamaspace
 
 #endif //PLAIN_RAGGED_MATRIX_HPP_
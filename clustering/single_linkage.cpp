@@ -0,0 +1,588 @@
+/******************************************************************************
+ * single_linkage.cpp: Implementation of the MST based single-linkage clustering.
+ *
+ * Author: Carlos Eduardo de Andrade
+ *         <carlos.andrade@gatech.edu / ce.andrade@gmail.com>
+ *
+ * (c) Copyright 2015-2019
+ *     Industrial and Systems Engineering, Georgia Institute of Technology
+ *     All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by andrade
+ *  Last update: Oct 18, 2026 by andrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "single_linkage.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <utility>
+
+using namespace std;
+
+namespace ce_andrade {
+
+//------------------------------[ Constructor ]-------------------------------//
+
+SingleLinkage::SingleLinkage(const FeatureMatrix &_features, const Metric _metric,
+                             const double _min_sharing):
+        features(_features),
+        transposed(_features.transpose()),
+        metric(_metric),
+        min_sharing(_min_sharing),
+        norms(),
+        sharing_factor(0.0),
+        num_rounds(0),
+        num_bands(0),
+        rows_per_band(0),
+        hash_seed(0),
+        candidate_begin(),
+        candidate_row(),
+        candidate_common(),
+        evaluated_pairs_fraction(1.0)
+{}
+
+//-----------------------------[ Approximation ]------------------------------//
+
+void SingleLinkage::setMinHash(const int bands, const int _rows_per_band,
+                               const unsigned seed) {
+    if(bands < 0 || (bands > 0 && _rows_per_band < 1))
+        throw runtime_error("Invalid MinHash parameters.");
+
+    num_bands = bands;
+    rows_per_band = _rows_per_band;
+    hash_seed = seed;
+}
+
+//-------------------------------[ Clustering ]-------------------------------//
+
+vector<ClusterTree::CClusteringLibNode> SingleLinkage::cluster() {
+    num_rounds = 0;
+    if(features.rows() < 2)
+        return vector<ClusterTree::CClusteringLibNode>();
+
+    computeNorms();
+    evaluated_pairs_fraction = 1.0;
+    if(num_bands > 0)
+        buildCandidates();
+
+    vector<Edge> tree(minimumSpanningTree());
+
+    // Release the candidate lists.
+    vector<long>().swap(candidate_begin);
+    vector<int>().swap(candidate_row);
+    vector<double>().swap(candidate_common);
+
+    return buildNodes(tree);
+}
+
+//---------------------------------[ Norms ]----------------------------------//
+
+void SingleLinkage::computeNorms() {
+    const int N = features.rows();
+    norms.assign(N, 0.0);
+    sharing_factor = 0.0;
+
+    if(metric != Metric::SHARED) {
+        for(int a = 0; a < N; ++a)
+            for(FeatureMatrix::InnerIterator it(features, a); it; ++it)
+                norms[a] += (metric == Metric::L1? fabs(it.value()) :
+                                                   it.value() * it.value());
+        return;
+    }
+
+    // In the approximate mode, the maximum sharing is taken over the
+    // candidate pairs only (see buildCandidates()).
+    if(num_bands > 0)
+        return;
+
+    // The maximum sharing is the largest off-diagonal entry of the product
+    // of the features' pattern by its transpose, computed row by row.
+    double max_sharing = 0.0;
+
+    #ifdef _OPENMP
+    #pragma omp parallel
+    #endif
+    {
+        vector<unsigned> count(N, 0);
+        vector<int> touched;
+        double local_max = 0.0;
+
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 64)
+        #endif
+        for(int a = 1; a < N; ++a) {
+            for(FeatureMatrix::InnerIterator it(features, a); it; ++it) {
+                for(FeatureMatrix::InnerIterator jt(transposed, it.index());
+                    jt && jt.index() < a; ++jt) {
+                    if(count[jt.index()]++ == 0)
+                        touched.push_back(jt.index());
+                }
+            }
+
+            for(const auto b : touched) {
+                if(count[b] >= min_sharing && local_max < count[b])
+                    local_max = count[b];
+                count[b] = 0;
+            }
+            touched.clear();
+        }
+
+        #ifdef _OPENMP
+        #pragma omp critical
+        #endif
+        if(max_sharing < local_max)
+            max_sharing = local_max;
+    }
+
+    sharing_factor = (max_sharing > 0.0? 1.0 / max_sharing : 0.0);
+}
+
+//--------------------------------[ Distance ]--------------------------------//
+
+inline double SingleLinkage::distance(const int a, const int b,
+                                      const double common) const {
+    switch(metric) {
+    case Metric::L1:
+        return max(0.0, norms[a] + norms[b] + common);
+
+    case Metric::L2:
+        return sqrt(max(0.0, norms[a] + norms[b] - 2.0 * common));
+
+    default:
+        return 1.0 - (common >= min_sharing? common : 0.0) * sharing_factor;
+    }
+}
+
+//------------------------------[ Common term ]-------------------------------//
+
+double SingleLinkage::commonTerm(const int a, const int b) const {
+    FeatureMatrix::InnerIterator it1(features, a);
+    FeatureMatrix::InnerIterator it2(features, b);
+    double common = 0.0;
+    while(it1 && it2) {
+        if(it1.index() < it2.index())
+            ++it1;
+        else if(it2.index() < it1.index())
+            ++it2;
+        else {
+            const double x = it1.value();
+            const double y = it2.value();
+            switch(metric) {
+            case Metric::L1:
+                common += fabs(x - y) - fabs(x) - fabs(y);
+                break;
+            case Metric::L2:
+                common += x * y;
+                break;
+            default:
+                common += 1.0;
+                break;
+            }
+            ++it1; ++it2;
+        }
+    }
+    return common;
+}
+
+//--------------------------[ MinHash candidates ]----------------------------//
+
+void SingleLinkage::buildCandidates() {
+    const int N = features.rows();
+    const int K = num_bands * rows_per_band;
+
+    // Universal hash functions h(c) = (A * c + B) mod P over the columns.
+    const uint64_t P = 2147483647ULL;   // 2^31 - 1
+    vector<uint64_t> A(K), B(K);
+    mt19937 rng(hash_seed);
+    uniform_int_distribution<uint64_t> dist_a(1, P - 1), dist_b(0, P - 1);
+    for(int k = 0; k < K; ++k) {
+        A[k] = dist_a(rng);
+        B[k] = dist_b(rng);
+    }
+
+    // The MinHash signatures, row by row.
+    vector<uint32_t> signature((size_t)N * K, numeric_limits<uint32_t>::max());
+
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 256)
+    #endif
+    for(int a = 0; a < N; ++a) {
+        uint32_t *sig = &signature[(size_t)a * K];
+        for(FeatureMatrix::InnerIterator it(features, a); it; ++it) {
+            const uint64_t c = (uint64_t)it.index() + 1;
+            for(int k = 0; k < K; ++k) {
+                const uint32_t h = (uint32_t)((A[k] * c + B[k]) % P);
+                if(h < sig[k])
+                    sig[k] = h;
+            }
+        }
+    }
+
+    // Bucket the rows by band. Rows without columns share nothing, and
+    // stay out. Key collisions only add some candidates.
+    vector<pair<uint64_t, int>> keys;
+    keys.reserve(N);
+    vector<pair<int, int>> pairs;
+
+    for(int band = 0; band < num_bands; ++band) {
+        keys.clear();
+        for(int a = 0; a < N; ++a) {
+            if(!FeatureMatrix::InnerIterator(features, a))
+                continue;
+
+            const uint32_t *sig = &signature[(size_t)a * K + band * rows_per_band];
+            uint64_t key = 14695981039346656037ULL;     // FNV-1a
+            for(int r = 0; r < rows_per_band; ++r) {
+                key ^= sig[r];
+                key *= 1099511628211ULL;
+            }
+            keys.emplace_back(key, a);
+        }
+
+        sort(keys.begin(), keys.end());
+
+        for(size_t i = 0; i < keys.size(); ++i)
+            for(size_t j = i + 1; j < keys.size() && j < i + LSH_WINDOW &&
+                keys[j].first == keys[i].first; ++j)
+                pairs.emplace_back(keys[i].second, keys[j].second);
+    }
+
+    vector<uint32_t>().swap(signature);
+    vector<pair<uint64_t, int>>().swap(keys);
+
+    sort(pairs.begin(), pairs.end());
+    pairs.erase(unique(pairs.begin(), pairs.end()), pairs.end());
+
+    evaluated_pairs_fraction = (double)pairs.size() /
+                               (0.5 * (double)N * (double)(N - 1));
+
+    // Symmetric candidate lists.
+    candidate_begin.assign(N + 1, 0);
+    for(const auto &pr : pairs) {
+        ++candidate_begin[pr.first + 1];
+        ++candidate_begin[pr.second + 1];
+    }
+    for(int a = 0; a < N; ++a)
+        candidate_begin[a + 1] += candidate_begin[a];
+
+    candidate_row.resize(candidate_begin[N]);
+    candidate_common.resize(candidate_begin[N]);
+
+    {
+        vector<long> position(candidate_begin.begin(), candidate_begin.end() - 1);
+        for(const auto &pr : pairs) {
+            candidate_row[position[pr.first]++] = pr.second;
+            candidate_row[position[pr.second]++] = pr.first;
+        }
+    }
+    vector<pair<int, int>>().swap(pairs);
+
+    // The terms over the common columns and, for Metric::SHARED, the
+    // maximum sharing among the candidates.
+    double max_sharing = 0.0;
+
+    #ifdef _OPENMP
+    #pragma omp parallel
+    #endif
+    {
+        double local_max = 0.0;
+
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 256)
+        #endif
+        for(int a = 0; a < N; ++a) {
+            for(long k = candidate_begin[a]; k < candidate_begin[a + 1]; ++k) {
+                candidate_common[k] = commonTerm(a, candidate_row[k]);
+                if(candidate_common[k] >= min_sharing && local_max < candidate_common[k])
+                    local_max = candidate_common[k];
+            }
+        }
+
+        #ifdef _OPENMP
+        #pragma omp critical
+        #endif
+        if(max_sharing < local_max)
+            max_sharing = local_max;
+    }
+
+    if(metric == Metric::SHARED)
+        sharing_factor = (max_sharing > 0.0? 1.0 / max_sharing : 0.0);
+}
+
+//-------------------------[ Minimum spanning tree ]--------------------------//
+
+bool SingleLinkage::lighter(const Edge &e1, const Edge &e2) {
+    return make_tuple(e1.distance, min(e1.from, e1.to), max(e1.from, e1.to)) <
+           make_tuple(e2.distance, min(e2.from, e2.to), max(e2.from, e2.to));
+}
+
+//----------------------------------------------------------------------------//
+
+vector<SingleLinkage::Edge> SingleLinkage::minimumSpanningTree() {
+    const int N = features.rows();
+    const double INF = numeric_limits<double>::infinity();
+
+    // Union-find over the rows.
+    vector<int> parent(N);
+    for(int a = 0; a < N; ++a)
+        parent[a] = a;
+
+    auto find = [&parent](int a) {
+        while(parent[a] != a) {
+            parent[a] = parent[parent[a]];
+            a = parent[a];
+        }
+        return a;
+    };
+
+    // The rows by increasing norm, where the closest row without common
+    // columns is looked for.
+    vector<int> order(N);
+    for(int a = 0; a < N; ++a)
+        order[a] = a;
+    stable_sort(order.begin(), order.end(),
+                [this](const int a, const int b) { return norms[a] < norms[b]; });
+
+    vector<int> component(N);
+    vector<int> next_other(N);
+    vector<Edge> best(N);
+    vector<Edge> component_best(N);
+
+    vector<Edge> tree;
+    tree.reserve(N - 1);
+
+    while((int)tree.size() < N - 1) {
+        ++num_rounds;
+
+        for(int a = 0; a < N; ++a)
+            component[a] = find(a);
+
+        // next_other[p] is the first position after p holding a row of
+        // other component than the row at p. So, a scan skips a whole run
+        // of rows of its component at once.
+        next_other[N - 1] = N;
+        for(int p = N - 2; p >= 0; --p)
+            next_other[p] = (component[order[p + 1]] != component[order[p]])?
+                            p + 1 : next_other[p + 1];
+
+        // The lightest edge leaving each row.
+        #ifdef _OPENMP
+        #pragma omp parallel
+        #endif
+        {
+            vector<double> common(N, 0.0);
+            vector<int> stamp(N, -1);
+            vector<int> touched;
+
+            #ifdef _OPENMP
+            #pragma omp for schedule(dynamic, 64)
+            #endif
+            for(int a = 0; a < N; ++a) {
+                Edge edge = {a, -1, INF};
+
+                if(num_bands > 0) {
+                    // The approximate candidates, computed beforehand.
+                    for(long k = candidate_begin[a]; k < candidate_begin[a + 1]; ++k) {
+                        const int b = candidate_row[k];
+                        stamp[b] = a;
+                        if(component[b] == component[a])
+                            continue;
+                        const Edge candidate = {a, b, distance(a, b, candidate_common[k])};
+                        if(lighter(candidate, edge))
+                            edge = candidate;
+                    }
+                }
+                else {
+                    // The candidates: rows sharing a column with a. We
+                    // accumulate the part of the distance due to the common
+                    // columns (the remaining is given by the norms).
+                    for(FeatureMatrix::InnerIterator it(features, a); it; ++it) {
+                        const double x = it.value();
+                        for(FeatureMatrix::InnerIterator jt(transposed, it.index()); jt; ++jt) {
+                            const int b = jt.index();
+                            const double y = jt.value();
+                            if(stamp[b] != a) {
+                                stamp[b] = a;
+                                common[b] = 0.0;
+                                touched.push_back(b);
+                            }
+
+                            switch(metric) {
+                            case Metric::L1:
+                                common[b] += fabs(x - y) - fabs(x) - fabs(y);
+                                break;
+                            case Metric::L2:
+                                common[b] += x * y;
+                                break;
+                            default:
+                                common[b] += 1.0;
+                                break;
+                            }
+                        }
+                    }
+
+                    for(const auto b : touched) {
+                        if(component[b] == component[a])
+                            continue;
+                        const Edge candidate = {a, b, distance(a, b, common[b])};
+                        if(lighter(candidate, edge))
+                            edge = candidate;
+                    }
+                    touched.clear();
+                }
+
+                // The closest row without common columns is the first one,
+                // by increasing norm, out of the candidates and component.
+                int p = 0;
+                while(p < N) {
+                    const int b = order[p];
+                    if(component[b] == component[a]) {
+                        p = next_other[p];
+                        continue;
+                    }
+                    if(stamp[b] == a) {
+                        ++p;
+                        continue;
+                    }
+                    const Edge candidate = {a, b, distance(a, b, 0.0)};
+                    if(lighter(candidate, edge))
+                        edge = candidate;
+                    break;
+                }
+
+                best[a] = edge;
+            }
+        }
+
+        // The lightest edge leaving each component.
+        for(int a = 0; a < N; ++a)
+            component_best[a].to = -1;
+
+        for(int a = 0; a < N; ++a) {
+            Edge &current = component_best[component[a]];
+            if(best[a].to >= 0 && (current.to < 0 || lighter(best[a], current)))
+                current = best[a];
+        }
+
+        // Merge the components.
+        for(int a = 0; a < N; ++a) {
+            if(component[a] != a || component_best[a].to < 0)
+                continue;
+
+            const Edge &edge = component_best[a];
+            const int root1 = find(edge.from);
+            const int root2 = find(edge.to);
+            if(root1 == root2)
+                continue;
+
+            parent[root2] = root1;
+            tree.push_back(edge);
+        }
+    }
+
+    return tree;
+}
+
+//-----------------------------[ Build the nodes ]----------------------------//
+
+vector<ClusterTree::CClusteringLibNode>
+SingleLinkage::buildNodes(vector<Edge> &tree) const {
+    const int N = features.rows();
+
+    sort(tree.begin(), tree.end(),
+         [](const Edge &e1, const Edge &e2) { return e1.distance < e2.distance; });
+
+    // SLINK pointer representation: lambda[j] is the level at which j stops
+    // being the largest row of its cluster, and pi[j] is the largest row of
+    // the cluster that j joins at that level. All merges on the same level
+    // are done before computing pi.
+    vector<int> parent(N);
+    vector<int> largest(N);
+    for(int a = 0; a < N; ++a) {
+        parent[a] = a;
+        largest[a] = a;
+    }
+
+    auto find = [&parent](int a) {
+        while(parent[a] != a) {
+            parent[a] = parent[parent[a]];
+            a = parent[a];
+        }
+        return a;
+    };
+
+    vector<double> lambda(N, numeric_limits<double>::infinity());
+    vector<int> pi(N, -1);
+    vector<int> joined;
+
+    for(size_t first = 0; first < tree.size(); ) {
+        size_t last = first;
+        while(last < tree.size() && !(tree[first].distance < tree[last].distance))
+            ++last;
+
+        for(size_t e = first; e < last; ++e) {
+            const int root1 = find(tree[e].from);
+            const int root2 = find(tree[e].to);
+            const int j = min(largest[root1], largest[root2]);
+            lambda[j] = tree[e].distance;
+            joined.push_back(j);
+
+            parent[root2] = root1;
+            largest[root1] = max(largest[root1], largest[root2]);
+        }
+
+        for(const auto j : joined)
+            pi[j] = largest[find(j)];
+        joined.clear();
+
+        first = last;
+    }
+
+    // Now, the nodes by level (ties by row) and the cluster IDs as the C
+    // clustering library does.
+    vector<int> rows;
+    rows.reserve(N - 1);
+    for(int j = 0; j < N; ++j)
+        if(pi[j] >= 0)
+            rows.push_back(j);
+
+    stable_sort(rows.begin(), rows.end(),
+                [&lambda](const int a, const int b) { return lambda[a] < lambda[b]; });
+
+    vector<int> index(N);
+    for(int a = 0; a < N; ++a)
+        index[a] = a;
+
+    vector<ClusterTree::CClusteringLibNode> nodes;
+    nodes.reserve(N - 1);
+
+    for(int i = 0; i < (int)rows.size(); ++i) {
+        const int j = rows[i];
+        const int k = pi[j];
+        nodes.emplace_back(index[j], index[k], lambda[j]);
+        index[k] = -i - 1;
+    }
+
+    return nodes;
+}
+
+} //endnamaspace
@@ -0,0 +1,264 @@
+/******************************************************************************
+ * single_linkage.hpp: Interface for the MST based single-linkage clustering.
+ *
+ * Author: Carlos Eduardo de Andrade
+ *         <carlos.andrade@gatech.edu / ce.andrade@gmail.com>
+ *
+ * (c) Copyright 2015-2019
+ *     Industrial and Systems Engineering, Georgia Institute of Technology
+ *     All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by andrade
+ *  Last update: Oct 18, 2026 by andrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef SINGLE_LINKAGE_HPP_
+#define SINGLE_LINKAGE_HPP_
+
+#include "cluster_tree.hpp"
+
+#include <vector>
+
+// Eigen has a lot of problems with some compile flags.
+// So, we just deactivate these flags here.
+#include "pragma_diagnostic_ignored_header.hpp"
+#include "Eigen/SparseCore"
+#include "pragma_diagnostic_ignored_footer.hpp"
+
+namespace ce_andrade {
+
+/**
+ * \brief Single Linkage
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * This class performs single-linkage hierarchical clustering of the rows of
+ * a sparse feature matrix without any distance matrix, i.e., using
+ * O(rows + non-zeros) memory. Single linkage is equivalent to the minimum
+ * spanning tree (MST) of the complete graph of distances, which is built by
+ * Borůvka's algorithm with the distances computed on the fly.
+ *
+ * The trick is that two rows without columns in common have a distance
+ * given only by their norms, increasing on each norm (for instance,
+ * |a|_1 + |b|_1 for L1). So, in each Borůvka round, a row only computes
+ * the distances to the rows sharing a column (its candidate list), and the
+ * closest of the other rows is the first one, by increasing norm, outside
+ * the candidate list and the row's component. The rows of a round are
+ * spread over the threads.
+ *
+ * For very large models, the candidate lists can be approximated by
+ * MinHash signatures of the rows' column sets bucketed by LSH bands (see
+ * setMinHash()). Only the pairs falling in a common bucket have their
+ * distances computed; all other pairs are taken as having no columns in
+ * common. Therefore, the tree is still a spanning one, but its distances
+ * may be larger than the exact ones.
+ *
+ * The result is the list of nodes in the same format as the C clustering
+ * library treecluster() with single linkage (SLINK pointer
+ * representation), ready to ClusterTree.
+ */
+class SingleLinkage {
+    public:
+        /** \name Enumerations */
+        //@{
+        /// The distance between two rows a and b.
+        enum class Metric {
+            /// The L1 norm of a - b.
+            L1,
+
+            /// The L2 norm of a - b.
+            L2,
+
+            /// 1 - sharing(a, b) / MAX, where sharing(a, b) is the number of
+            /// columns in which both rows have non-zeros (taken as zero if
+            /// less than min_sharing), and MAX is the maximum sharing over all
+            /// pairs.
+            SHARED
+        };
+        //@}
+
+        /** Type definitions */
+        //@{
+        /// The feature matrix: one row per object.
+        typedef Eigen::SparseMatrix<double, Eigen::RowMajor> FeatureMatrix;
+        //@}
+
+    public:
+        /** \name Constructor */
+        //@{
+        /** \brief Default Constructor.
+         * \param features one row per object. The matrix must outlive this
+         *        object.
+         * \param metric used to compute the distances.
+         * \param min_sharing used only by Metric::SHARED.
+         */
+        SingleLinkage(const FeatureMatrix &features, const Metric metric,
+                      const double min_sharing = 1.0);
+        //@}
+
+        /** \name Clustering */
+        //@{
+        /** \brief Cluster the rows of the feature matrix.
+         * \return rows - 1 nodes, sorted by distance, as the C clustering
+         *         library does. Leaves are the row indices, and node i is
+         *         referred as -i - 1.
+         */
+        std::vector<ClusterTree::CClusteringLibNode> cluster();
+
+        /// Returns the number of Borůvka rounds of the last clustering.
+        int getNumRounds() const {
+            return num_rounds;
+        }
+
+        /// Returns the fraction of all pairs of rows that had their
+        /// distances computed in the last clustering. Only meaningful in
+        /// the approximate mode (1.0 otherwise).
+        double getEvaluatedPairsFraction() const {
+            return evaluated_pairs_fraction;
+        }
+        //@}
+
+        /** \name Approximation */
+        //@{
+        /** \brief Use MinHash/LSH candidate lists instead of the exact ones.
+         * Each row gets a signature of bands x rows_per_band MinHash values,
+         * and two rows are candidates if they agree on all values of at
+         * least one band. More bands raise the recall; more rows per band
+         * raise the precision (and the speed). Rows with Jaccard similarity
+         * s are candidates with probability 1 - (1 - s^rows_per_band)^bands.
+         * \param bands number of bands. Zero turns off the approximation.
+         * \param rows_per_band number of MinHash values per band.
+         * \param seed for the hash functions.
+         */
+        void setMinHash(const int bands, const int rows_per_band,
+                        const unsigned seed = 0);
+        //@}
+
+    private:
+        SingleLinkage(const SingleLinkage&) = delete;
+        SingleLinkage& operator=(const SingleLinkage&) = delete;
+
+    protected:
+        /** Type definitions */
+        //@{
+        /// An edge of the minimum spanning tree.
+        struct Edge {
+            int from;
+            int to;
+            double distance;
+        };
+        //@}
+
+        /** Constants */
+        //@{
+        /// In the approximate mode, each row of a bucket is paired with the
+        /// next LSH_WINDOW - 1 rows of it, only. So, huge buckets of
+        /// (almost) identical rows do not generate a quadratic number of
+        /// pairs, and still are connected.
+        static const int LSH_WINDOW = 32;
+        //@}
+
+        /** Data */
+        //@{
+        /// The features, one row per object.
+        const FeatureMatrix &features;
+
+        /// The transpose of the features, used to find the candidate lists.
+        FeatureMatrix transposed;
+
+        /// The metric.
+        Metric metric;
+
+        /// Smallest sharing taken into account (Metric::SHARED only).
+        double min_sharing;
+
+        /// The norm of each row: |a|_1 for L1, |a|^2 for L2, and zero for
+        /// SHARED.
+        std::vector<double> norms;
+
+        /// 1 / MAX for Metric::SHARED.
+        double sharing_factor;
+
+        /// Number of Borůvka rounds of the last clustering.
+        int num_rounds;
+        //@}
+
+        /** Approximation data */
+        //@{
+        /// Number of LSH bands. Zero for the exact mode.
+        int num_bands;
+
+        /// Number of MinHash values per band.
+        int rows_per_band;
+
+        /// Seed of the hash functions.
+        unsigned hash_seed;
+
+        /// Candidate lists in compressed form: the candidates of row a are
+        /// candidate_row[candidate_begin[a] .. candidate_begin[a + 1]).
+        std::vector<long> candidate_begin;
+
+        /// The candidate rows.
+        std::vector<int> candidate_row;
+
+        /// The term over the common columns of each candidate pair (see
+        /// distance()).
+        std::vector<double> candidate_common;
+
+        /// Fraction of the pairs evaluated in the last clustering.
+        double evaluated_pairs_fraction;
+        //@}
+
+    protected:
+        /** Helper functions */
+        //@{
+        /// Compute the norms of the rows and, for Metric::SHARED, the
+        /// maximum sharing.
+        void computeNorms();
+
+        /// Distance between rows a and b given the accumulated term over
+        /// their common columns (see minimumSpanningTree()); zero if they
+        /// have no common columns.
+        double distance(const int a, const int b, const double common) const;
+
+        /// The term over the common columns of rows a and b (see
+        /// distance()), merging their sorted column lists.
+        double commonTerm(const int a, const int b) const;
+
+        /// Build the approximate candidate lists by MinHash/LSH.
+        void buildCandidates();
+
+        /// Total order on the edges: by distance, and then by their
+        /// smallest and largest rows, so Borůvka does not build cycles on
+        /// ties. For edges leaving the same row, it is the order by
+        /// distance and then by target row. Compares the distances with
+        /// operator< only.
+        static bool lighter(const Edge &e1, const Edge &e2);
+
+        /// Build the minimum spanning tree by Borůvka's algorithm.
+        std::vector<Edge> minimumSpanningTree();
+
+        /// Convert the minimum spanning tree in the C clustering library
+        /// nodes (SLINK pointer representation).
+        std::vector<ClusterTree::CClusteringLibNode> buildNodes(std::vector<Edge> &tree) const;
+        //@}
+};
+
+} //endnamaspace
+
+#endif //SINGLE_LINKAGE_HPP_
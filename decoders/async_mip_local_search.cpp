@@ -0,0 +1,136 @@
+/******************************************************************************
+ * async_mip_local_search.cpp: Implementation for AsyncMIPLocalSearch class.
+ *
+ * Author: Carlos Eduardo de Andrade
+ *         <carlos.andrade@gatech.edu / ce.andrade@gmail.com>
+ *
+ * (c) Copyright 2015-2019
+ *     Industrial and Systems Engineering, Georgia Institute of Technology
+ *     All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by andrade
+ *  Last update: Oct 18, 2026 by andrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "async_mip_local_search.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+//-------------------------[ Default Constructor ]----------------------------//
+
+AsyncMIPLocalSearch::AsyncMIPLocalSearch(FeasibilityPump_Decoder& _decoder,
+                                         std::function<void(bool)> _on_finish):
+        decoder(_decoder),
+        on_finish(_on_finish),
+        worker(),
+        finished(false),
+        snapshot(),
+        solution(),
+        found(false),
+        num_unfixed_vars(0),
+        error(),
+        last_time()
+{}
+
+//-----------------------------[ Destructor ]---------------------------------//
+
+AsyncMIPLocalSearch::~AsyncMIPLocalSearch() {
+    cancel();
+}
+
+//-------------------------------[ Launch ]-----------------------------------//
+
+bool AsyncMIPLocalSearch::launch(const Population& population,
+                                 const unsigned num_chromosomes,
+                                 const unsigned unfix_level,
+                                 const double max_time) {
+    if(worker.joinable())
+        return false;
+
+    snapshot.reset(new Population(population));
+    solution = population.getChromosome(0);
+    found = false;
+    num_unfixed_vars = 0;
+    error = nullptr;
+    finished = false;
+
+    decoder.clearMIPLocalSearchAbort();
+
+    worker = thread([this, num_chromosomes, unfix_level, max_time]() {
+        boost::timer::cpu_timer timer;
+        try {
+            found = decoder.performMIPLocalSearch(*snapshot, num_chromosomes,
+                                                  unfix_level, max_time,
+                                                  solution, num_unfixed_vars);
+        }
+        catch(...) {
+            error = current_exception();
+            found = false;
+        }
+        last_time = timer.elapsed();
+
+        finished = true;
+        if(on_finish)
+            on_finish(found);
+    });
+
+    return true;
+}
+
+//-------------------------------[ Collect ]----------------------------------//
+
+bool AsyncMIPLocalSearch::collect(Chromosome& possible_feasible,
+                                  size_t& _num_unfixed_vars) {
+    if(!worker.joinable())
+        return false;
+
+    worker.join();
+    finished = false;
+
+    if(error) {
+        auto tmp = error;
+        error = nullptr;
+        rethrow_exception(tmp);
+    }
+
+    _num_unfixed_vars = num_unfixed_vars;
+    if(found) {
+        copy(solution.begin(), solution.end(), possible_feasible.begin());
+        copy(solution.rounded.begin(), solution.rounded.end(),
+             possible_feasible.rounded.begin());
+        possible_feasible.feasibility_pump_value = solution.feasibility_pump_value;
+        possible_feasible.fractionality = solution.fractionality;
+        possible_feasible.num_non_integral_vars = solution.num_non_integral_vars;
+    }
+
+    return found;
+}
+
+//-------------------------------[ Cancel ]-----------------------------------//
+
+void AsyncMIPLocalSearch::cancel() {
+    if(!worker.joinable())
+        return;
+
+    decoder.abortMIPLocalSearch();
+    worker.join();
+    finished = false;
+    error = nullptr;
+    found = false;
+}
@@ -9,7 +9,7 @@
  *     All Rights Reserved.
  *
  *  Created on : Feb 18, 2015 by andrade
- *  Last update: Ago 10, 2015 by andrade
+ *  Last update: Oct 18, 2026 by andrade
  *
  * This code is released under LICENSE.md.
  *
@@ -34,14 +34,18 @@
 #include <sstream>
 #include <stdexcept>
 #include <vector>
+#include <unordered_set>
+#include <limits>
 #include <algorithm>
 #include <utility>
 #include <functional>
 #include <numeric>
 #include <cmath>
-#include <unordered_set>
+#include <chrono>
 #include <omp.h>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include "pragma_diagnostic_ignored_header.hpp"
 #include <ilcp/cp.h>
 #include "cpxutils.h"
@@ -55,6 +59,7 @@ using namespace std;
 ILOSTLBEGIN
 
 const double FeasibilityPump_Decoder::EPS = 1e-10;
+const size_t FeasibilityPump_Decoder::DECODE_TIME_WINDOW = 32;
 
 //----------------------------------------------------------------------------//
 // Default Constructor and Destructor
@@ -106,9 +111,17 @@ FeasibilityPump_Decoder::FeasibilityPump_Decoder(const char* _instance_file,
         frac_fp_per_thread(_num_threads),
         rounded_fp_per_thread(_num_threads),
         frac2int_per_thread(_num_threads, nullptr),
-        cuts_per_thread(),
-        rounding_cuts(),
-        constraints_per_variable(),
+        attached_cuts_per_thread(_num_threads),
+        reduced_model_per_thread(_num_threads),
+        decode_deadline_per_thread(_num_threads,
+                                   chrono::steady_clock::time_point::max()),
+        decode_times_per_thread(_num_threads, vector<double>(DECODE_TIME_WINDOW, 0.0)),
+        num_decodes_per_thread(_num_threads, 0),
+        rounding_cut_pool(),
+        max_attached_cuts(100),
+        max_cut_slack_age(5),
+        local_search_cuts(),
+        constraint_matrix(),
         full_relaxation_variable_values(),
         duals(),
         slacks(),
@@ -123,8 +136,31 @@ FeasibilityPump_Decoder::FeasibilityPump_Decoder(const char* _instance_file,
         num_constraints_used(0),
         discrepancy_level(_discrepancy_level),
         binary_variables_bounds(),
+        mip_local_search_decomposition(DecompositionType::NONE),
+        cluster_per_binary(),
+        mip_local_search_abort(false),
+        mip_local_search_portfolio(),
+        portfolio_solved(false),
+        num_mip_starts(0),
+        elite_roundings(),
+        reduced_models(false),
+        reduced_models_active(false),
+        reduced_to_full(),
+        full_to_reduced(),
+        num_reduced_rows(0),
+        lp_work_limit(0.0),
+        decode_budget_factor(0.0),
+        component_rounding_threads(0),
+        rounding_probing_time(0.0),
         solved_lps_per_thread(_num_threads, 0),
+        cut_short_decodes_per_thread(_num_threads, 0),
         feasible_before_var_unfixing(false),
+        num_subproblems(0),
+        num_feasible_subproblems(0),
+        portfolio_winner(-1),
+        num_started_subproblems(0),
+        num_mip_starts_accepted(0),
+        num_mip_starts_repaired(0),
         initialized(false),
         chromosome_size(0),
         sense(Sense::MINIMIZE),
@@ -149,7 +185,6 @@ FeasibilityPump_Decoder::FeasibilityPump_Decoder(const char* _instance_file,
     current_values_per_thread.reserve(_num_threads);
     previous_values_per_thread.reserve(_num_threads);
     rounded_values_per_thread.reserve(_num_threads);
-    cuts_per_thread.reserve(_num_threads);
 
     for(auto &env : environment_per_thread) {
         model_per_thread.emplace_back(env);
@@ -162,9 +197,14 @@ FeasibilityPump_Decoder::FeasibilityPump_Decoder(const char* _instance_file,
         current_values_per_thread.emplace_back(env);
         previous_values_per_thread.emplace_back(env);
         rounded_values_per_thread.emplace_back(env);
-        cuts_per_thread.emplace_back(env);
     }
 
+    // The rounding cut pool is purged when it reaches 1000 cuts or 256 MB.
+    // Note that each cut is dense over the binaries.
+    rounding_cut_pool.name = "RoundingCutPool";
+    rounding_cut_pool.maxSize = 1000;
+    rounding_cut_pool.maxMemory = 256.0 * 1024 * 1024;
+
     #ifndef DEBUG
     for(auto &env : environment_per_thread) {
         env.setOut(env.getNullStream());
@@ -246,6 +286,28 @@ void FeasibilityPump_Decoder::init() {
     RankerFactory::getInstance().registerClass<FractionalityRanker>("FRAC");
     dominiqs::TransformersFactory::getInstance().registerClass<PropagatorRounding>("propround");
 
+    // The rounders read the component-parallel rounding and the probing
+    // from the global configuration. Each decoding thread rounds its
+    // blocks with its own team, so the nested teams are bounded by the
+    // processors.
+    unsigned rounding_threads = component_rounding_threads;
+    #ifdef _OPENMP
+    rounding_threads = min(rounding_threads,
+                           max(1u, unsigned(omp_get_num_procs()) / unsigned(num_threads)));
+    if(rounding_threads > 1)
+        omp_set_max_active_levels(max(omp_get_max_active_levels(), 2));
+    #else
+    rounding_threads = 1;
+    #endif
+    dominiqs::gConfig().set<bool>("FeasibilityPump", "componentParallel",
+                                  rounding_threads > 1);
+    dominiqs::gConfig().set<int>("FeasibilityPump", "componentThreads",
+                                 int(rounding_threads));
+    dominiqs::gConfig().set<bool>("FeasibilityPump", "probing",
+                                  rounding_probing_time > 0.0);
+    dominiqs::gConfig().set<double>("FeasibilityPump", "probingTimeLimit",
+                                    rounding_probing_time);
+
     // Load the model in each algorithm.
     // TODO: this is very ugly! We must find some way more simple.
     for(size_t i = 0; i < model_per_thread.size(); ++i) {
@@ -268,9 +330,14 @@ void FeasibilityPump_Decoder::init() {
         DOMINIQS_ASSERT(frac2int_per_thread[i]);
         frac2int_per_thread[i]->readConfig();
 
-        dominiqs::Model domModel;
-        domModel.extract(m_env, m_lp);
-        frac2int_per_thread[i]->init(domModel, true);
+        // Only the first rounder extracts the model and builds the
+        // propagators. The others share their read-only structure
+        // (rows, coefficients) and keep only their own mutable state.
+        if(i == 0 || !frac2int_per_thread[i]->initFrom(*frac2int_per_thread[0], true)) {
+            dominiqs::Model domModel;
+            domModel.extract(m_env, m_lp);
+            frac2int_per_thread[i]->init(domModel, true);
+        }
     }
 
     // Now, let tight some variable bounds.
@@ -293,17 +360,17 @@ void FeasibilityPump_Decoder::init() {
     cp.extract(model_cp);
     cp.propagate();
 
-    variables_id_index.reserve(variables_per_thread[0].getSize());
-
     for(IloInt j = 0; j < variables_per_thread[0].getSize(); ++j) {
         auto &var = variables_per_thread[0][j];
         for(int i = 0; i < num_threads; ++i)
             variables_per_thread[i][j].setBounds(cp.getMin(var), cp.getMax(var));
-
-        variables_id_index[var.getId()] = j;
     }
     #endif
 
+    variables_id_index.reserve(variables_per_thread[0].getSize());
+    for(IloInt j = 0; j < variables_per_thread[0].getSize(); ++j)
+        variables_id_index[variables_per_thread[0][j].getId()] = j;
+
     #ifdef DEBUG
     cout << "\n\nFinding binary vars..."; cout.flush();
     #endif
@@ -613,25 +680,74 @@ void FeasibilityPump_Decoder::buildConstraint2VariableMatrix() {
          << endl;
     #endif
 
-    // Now, build the constraint-variable matrix
-    constraints_per_variable.clear();
-    constraints_per_variable.resize(binary_variables_per_thread[0].getSize());
+    // Now, copy the constraints over the binary variables in CSR format.
+    auto &constraints = constraints_per_thread[0];
+    const IloInt NUM_BINARIES = binary_variables_per_thread[0].getSize();
+    const IloInt NUM_CONSTRAINTS = constraints.getSize();
+    auto &matrix = constraint_matrix;
+
+    matrix = BinaryConstraintMatrix();
+    matrix.row_begin.reserve(NUM_CONSTRAINTS + 1);
+    matrix.type.reserve(NUM_CONSTRAINTS);
+    matrix.bounds.reserve(NUM_CONSTRAINTS);
+    matrix.other_positive.reserve(NUM_CONSTRAINTS);
+    matrix.other_negative.reserve(NUM_CONSTRAINTS);
+
+    for(IloInt i = 0; i < NUM_CONSTRAINTS; ++i) {
+        auto &ctr = constraints[i];
+        double positive = 0.0;
+        double negative = 0.0;
 
-    for(auto &v : constraints_per_variable)
-        v.reserve(constraints_per_thread[0].getSize());
+        matrix.row_begin.push_back(matrix.index.size());
 
-    for(auto ctr_idx : ctr_sorting) {
-        auto &ctr = constraints_per_thread[0][ctr_idx];
         for(auto it = ctr.getLinearIterator(); it.ok(); ++it) {
             auto var = it.getVar();
-            if(var.getType() == IloNumVar::Bool)
-                constraints_per_variable[binary_variables_id_index[var.getId()]]
-                                         .push_back(ctr);
+            auto value = it.getCoef();
+
+            if(var.getType() == IloNumVar::Bool) {
+                matrix.index.push_back(int(binary_variables_id_index[var.getId()]));
+                matrix.coef.push_back(value);
+            }
+            else if(value > 0)
+                positive += value;
+            else
+                negative += value;
         }
+
+        matrix.other_positive.push_back(positive);
+        matrix.other_negative.push_back(negative);
+
+        const IloNum lb = ctr.getLB();
+        const IloNum ub = ctr.getUB();
+        matrix.bounds.emplace_back(lb, ub);
+
+        if(lb <= -IloInfinity && ub < IloInfinity)
+            matrix.type.push_back('l');
+        else if(lb > -IloInfinity && ub >= IloInfinity)
+            matrix.type.push_back('g');
+        else if(fabs(ub - lb) < EPS)
+            matrix.type.push_back('e');
+        else
+            matrix.type.push_back('r');
     }
+    matrix.row_begin.push_back(matrix.index.size());
 
-    for(auto &v : constraints_per_variable)
-        v.shrink_to_fit();
+    // And the filtered constraints of each binary variable, in CSC format.
+    matrix.column_begin.assign(NUM_BINARIES + 1, 0);
+    for(auto ctr_idx : ctr_sorting)
+        for(size_t k = matrix.row_begin[ctr_idx]; k < matrix.row_begin[ctr_idx + 1]; ++k)
+            ++matrix.column_begin[matrix.index[k] + 1];
+
+    partial_sum(matrix.column_begin.begin(), matrix.column_begin.end(),
+                matrix.column_begin.begin());
+
+    matrix.rows.resize(matrix.column_begin.back());
+    vector<size_t> next_position(matrix.column_begin.begin(),
+                                 matrix.column_begin.end() - 1);
+
+    for(auto ctr_idx : ctr_sorting)
+        for(size_t k = matrix.row_begin[ctr_idx]; k < matrix.row_begin[ctr_idx + 1]; ++k)
+            matrix.rows[next_position[matrix.index[k]]++] = int(ctr_idx);
 
     num_constraints_used = ctr_sorting.size();
 
@@ -996,9 +1112,34 @@ double FeasibilityPump_Decoder::decode(Chromosome& chromosome, bool /*writeback*
     if(!initialized)
         throw std::runtime_error("Decoder did not initialized");
 
+    #ifdef _OPENMP
+    const int thread = omp_get_thread_num();
+    #else
+    const int thread = 0;
+    #endif
+
+    // The budget of this decoding is a multiple of the median time of the
+    // last decodings of this thread.
+    auto &decode_times = decode_times_per_thread[thread];
+    auto &num_decodes = num_decodes_per_thread[thread];
+    const auto start = chrono::steady_clock::now();
+
+    decode_deadline_per_thread[thread] = chrono::steady_clock::time_point::max();
+    if(decode_budget_factor > 0.0 && num_decodes >= DECODE_TIME_WINDOW) {
+        vector<double> times(decode_times);
+        nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+        decode_deadline_per_thread[thread] = start +
+            chrono::duration_cast<chrono::steady_clock::duration>(
+                chrono::duration<double>(decode_budget_factor * times[times.size() / 2]));
+    }
+
     objectiveFeasibilityPump(chromosome, objective_fp_params.phi,
                              objective_fp_params.delta);
 
+    decode_times[num_decodes % DECODE_TIME_WINDOW] =
+        chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    ++num_decodes;
+
     #ifdef DEBUG
     cout << "\n--------------------------------\n"
          << "> Computing infeasibility"
@@ -1026,10 +1167,58 @@ double FeasibilityPump_Decoder::decode(Chromosome& chromosome, bool /*writeback*
     return performance;
 }
 
+//----------------------------------------------------------------------------//
+// Pump limits
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::setLPWorkLimit(const double ticks) {
+    if(ticks < 0.0)
+        throw runtime_error("The LP work limit must be non-negative.");
+    lp_work_limit = ticks;
+}
+
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::setDecodeTimeBudget(const double factor) {
+    if(factor < 0.0 || (factor > 0.0 && factor < 1.0))
+        throw runtime_error("The decoding budget factor must be zero or at least one.");
+    decode_budget_factor = factor;
+}
+
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::setComponentRoundingThreads(const unsigned _num_threads) {
+    if(initialized)
+        throw runtime_error("The rounding threads must be set before init().");
+    component_rounding_threads = _num_threads;
+}
+
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::setRoundingProbing(const double time_limit) {
+    if(initialized)
+        throw runtime_error("The rounding probing must be set before init().");
+    if(time_limit < 0.0)
+        throw runtime_error("The probing time limit must be non-negative.");
+    rounding_probing_time = time_limit;
+}
+
 //----------------------------------------------------------------------------//
 // Analyze and fix vars
 //----------------------------------------------------------------------------//
 
+// Record where the first incumbent came from (e.g., from a MIP start).
+ILOINCUMBENTCALLBACK1(RecordIncumbentSourceCallback, int*, first_source) {
+    if(!hasIncumbent() && *first_source == -1)
+        *first_source = int(getSolutionSource());
+}
+
+// Stop the MIP on user interruption, time, or abortMIPLocalSearch().
+ILOMIPINFOCALLBACK1(StopCtrlCorTimeCallback, const FeasibilityPump_Decoder*, decoder) {
+    if(decoder->mustStopMIPLocalSearch())
+        abort();
+}
+
 bool FeasibilityPump_Decoder::analyzeAndFixVars(const Population& population,
                                                 const unsigned num_chromosomes,
                                                 const FixingType fixing,
@@ -1053,24 +1242,14 @@ bool FeasibilityPump_Decoder::analyzeAndFixVars(const Population& population,
     // First, we undo the previous variable fixing
     const auto NUM_BINARIES = binary_variables.getSize();
 
-    for(int i = 0; i < num_threads; ++i)
-        for(IloInt j = 0; j < NUM_BINARIES; ++j)
-            binary_variables_per_thread[i][j]
-                         .setBounds(binary_variables_bounds[j].lb,
-                                    binary_variables_bounds[j].ub);
-
     fill(fixed_vars.begin(), fixed_vars.end(), -1);
+    setBinaryFixing(fixed_vars);
+    clearReducedModels();
 
-    // Now, build the histogram.
-    vector<int> histogram(population.getN(), 0);
+    // Now, take the histogram (kept by the population).
+    const vector<int> &histogram = population.getEliteHistogram(num_chromosomes);
     vector<UpperLowerBounds> old_bounds(population.getN());
 
-    for(unsigned i = 0; i < num_chromosomes; ++i) {
-        auto &chr = population.getChromosome(i);
-        for(size_t j = 0; j < population.getN(); ++j)
-            histogram[j] += chr.rounded[j];
-    }
-
     vector<pair<float, size_t>> to_be_fixed(NUM_BINARIES);
     for(IloInt j = 0; j < NUM_BINARIES; ++j) {
         float value;
@@ -1129,14 +1308,35 @@ bool FeasibilityPump_Decoder::analyzeAndFixVars(const Population& population,
     cplex.setParam(IloCplex::Param::MIP::Display, 4);
     #endif
 
+    // Give the elite roundings as starting points.
+    vector<int8_t> probe_fixing(NUM_BINARIES, -1);
+    for(IloInt j = 0; j < NUM_BINARIES; ++j)
+        if(binary_variables[j].getLB() > binary_variables[j].getUB() - EPS)
+            probe_fixing[j] = int8_t(round(binary_variables[j].getLB()));
+
+    collectEliteRoundings(population, num_chromosomes);
+    const int num_starts = addEliteMIPStarts(0, probe_fixing);
+
+    int first_source = -1;
+    auto record_incumbent_source_callback =
+            RecordIncumbentSourceCallback(environment_per_thread[0], &first_source);
+    auto stop_ctrl_c_or_time_callback =
+            StopCtrlCorTimeCallback(environment_per_thread[0], this);
+    cplex.use(record_incumbent_source_callback);
+    cplex.use(stop_ctrl_c_or_time_callback);
+
     cplex.solve();
 
+    cplex.remove(stop_ctrl_c_or_time_callback);
+    cplex.remove(record_incumbent_source_callback);
+    accountMIPStarts(0, probe_fixing, num_starts, first_source,
+                     cplex.getStatus() == IloAlgorithm::Feasible ||
+                     cplex.getStatus() == IloAlgorithm::Optimal);
+
     // If infeasible, unfix vars and return fail.
     bool worked = true;
     if(cplex.getStatus() == IloAlgorithm::Infeasible) {
-        for(IloInt j = 0; j < NUM_BINARIES; ++j)
-            binary_variables[j].setBounds(binary_variables_bounds[j].lb,
-                                          binary_variables_bounds[j].ub);
+        setBinaryFixing(fixed_vars, 0);
         worked = false;
         #ifdef DEBUG
         cout << "\n* After CPLEX probing: " << cplex.getCplexStatus() << endl;
@@ -1147,11 +1347,15 @@ bool FeasibilityPump_Decoder::analyzeAndFixVars(const Population& population,
     if(cplex.getStatus() == IloAlgorithm::Unknown) { // &&
 //       cplex.getCplexStatus() == IloCplex::AbortTimeLim) {
 
-        for(int i = 0; i < num_threads; ++i)
-            for(IloInt j = 0; j < NUM_BINARIES; ++j)
-                binary_variables_per_thread[i][j]
-                             .setBounds(binary_variables[j].getLB(),
-                                        binary_variables[j].getUB());
+        vector<IloInt> indices(NUM_BINARIES);
+        vector<UpperLowerBounds> bounds(NUM_BINARIES);
+        for(IloInt j = 0; j < NUM_BINARIES; ++j) {
+            indices[j] = j;
+            bounds[j].lb = binary_variables[j].getLB();
+            bounds[j].ub = binary_variables[j].getUB();
+        }
+
+        setBinaryBounds(indices, bounds);
 
         for(IloInt j = 0; j < NUM_BINARIES; ++j) {
             if(binary_variables[j].getLB() < binary_variables[j].getUB())
@@ -1198,11 +1402,310 @@ bool FeasibilityPump_Decoder::analyzeAndFixVars(const Population& population,
     #ifdef DEBUG
     cplex.setParam(IloCplex::Param::MIP::Display, 0);
     environment_per_thread[0].setOut(environment_per_thread[0].getNullStream());
+    #endif
+
+    // From now on, the projections do not carry the fixed variables.
+    if(reduced_models)
+        buildReducedModels();
+
+    #ifdef DEBUG
     cout << "\n--------------------------------\n" << endl;
     #endif
     return worked;
 }
 
+//----------------------------------------------------------------------------//
+// Bound updates
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::setBinaryBounds(const vector<IloInt>& indices,
+                                              const vector<UpperLowerBounds>& bounds,
+                                              const int thread) {
+    if(indices.empty())
+        return;
+
+    const int first_thread = (thread < 0)? 0 : thread;
+    const int last_thread = (thread < 0)? num_threads : thread + 1;
+    const IloInt num_changes = indices.size();
+
+    // Each thread has its own environment, so they can be changed together.
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(last_thread - first_thread) \
+        schedule(static, 1) if(last_thread - first_thread > 1)
+    #endif
+    for(int t = first_thread; t < last_thread; ++t) {
+        auto &env = environment_per_thread[t];
+        auto &binary_variables = binary_variables_per_thread[t];
+
+        IloNumVarArray vars(env, num_changes);
+        IloNumArray lbs(env, num_changes);
+        IloNumArray ubs(env, num_changes);
+
+        for(IloInt i = 0; i < num_changes; ++i) {
+            vars[i] = binary_variables[indices[i]];
+            lbs[i] = bounds[i].lb;
+            ubs[i] = bounds[i].ub;
+        }
+
+        vars.setBounds(lbs, ubs);
+
+        vars.end();
+        lbs.end();
+        ubs.end();
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::setBinaryFixing(const vector<int8_t>& fixing,
+                                              const int thread) {
+    const IloInt NUM_BINARIES = binary_variables_per_thread[0].getSize();
+
+    vector<IloInt> indices(NUM_BINARIES);
+    vector<UpperLowerBounds> bounds(NUM_BINARIES);
+
+    for(IloInt j = 0; j < NUM_BINARIES; ++j) {
+        indices[j] = j;
+        if(fixing[j] == -1)
+            bounds[j] = binary_variables_bounds[j];
+        else
+            bounds[j] = UpperLowerBounds(fixing[j], fixing[j]);
+    }
+
+    setBinaryBounds(indices, bounds, thread);
+}
+
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::applyFixing(const vector<int8_t>& fixing) {
+    if(fixing.size() != fixed_vars.size())
+        throw runtime_error("The fixing must have one value per binary variable.");
+
+    clearReducedModels();
+
+    fixed_vars = fixing;
+    setBinaryFixing(fixed_vars);
+
+    if(reduced_models)
+        buildReducedModels();
+}
+
+//----------------------------------------------------------------------------//
+// Reduced models
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::buildReducedModels() {
+    clearReducedModels();
+
+    const IloInt NUM_BINARIES = binary_variables_per_thread[0].getSize();
+    auto &variables = variables_per_thread[0];
+
+    full_to_reduced.assign(NUM_BINARIES, -1);
+    for(IloInt j = 0; j < NUM_BINARIES; ++j) {
+        if(fixed_vars[j] == -1) {
+            full_to_reduced[j] = reduced_to_full.size();
+            reduced_to_full.push_back(j);
+        }
+    }
+
+    if((IloInt)reduced_to_full.size() == NUM_BINARIES) {
+        reduced_to_full.clear();
+        full_to_reduced.clear();
+        return;
+    }
+
+    // The rounding cuts are attached again, on demand, to the reduced models.
+    detachRoundingCuts();
+
+    #ifdef DEBUG
+    cout << "\n\n> Building the reduced models..."; cout.flush();
+    #endif
+
+    // Fixed value of a variable, or -1 if it is free.
+    auto fixed_value = [&](const IloNumVar& var) -> int8_t {
+        const auto it = binary_variables_id_index.find(var.getId());
+        return (it == binary_variables_id_index.end())? -1 : fixed_vars[it->second];
+    };
+
+    // The rows (from thread 0) with the fixed variables moved to the
+    // bounds, as indices of variables_per_thread. Rows that the free
+    // variables cannot violate anymore (including the empty ones) are
+    // dropped.
+    vector<size_t> row_begin(1, 0);
+    vector<IloInt> row_index;
+    vector<IloNum> row_coef;
+    vector<UpperLowerBounds> row_bounds;
+
+    for(IloInt i = 0; i < constraints_per_thread[0].getSize(); ++i) {
+        const auto &ctr = constraints_per_thread[0][i];
+        IloNum fixed_activity = 0.0;
+        IloNum min_activity = 0.0;
+        IloNum max_activity = 0.0;
+
+        for(auto it = ctr.getLinearIterator(); it.ok(); ++it) {
+            const IloNum coef = it.getCoef();
+            const auto var = it.getVar();
+            const int8_t value = fixed_value(var);
+
+            if(value != -1) {
+                fixed_activity += coef * value;
+                continue;
+            }
+
+            min_activity += coef * ((coef > 0.0)? var.getLB() : var.getUB());
+            max_activity += coef * ((coef > 0.0)? var.getUB() : var.getLB());
+            row_index.push_back(variables_id_index[var.getId()]);
+            row_coef.push_back(coef);
+        }
+
+        const IloNum lb = (ctr.getLB() <= -IloInfinity)?
+                          -IloInfinity : ctr.getLB() - fixed_activity;
+        const IloNum ub = (ctr.getUB() >= IloInfinity)?
+                          IloInfinity : ctr.getUB() - fixed_activity;
+
+        if((lb <= -IloInfinity || min_activity > lb - EPS) &&
+           (ub >= IloInfinity || max_activity < ub + EPS)) {
+            row_index.resize(row_begin.back());
+            row_coef.resize(row_begin.back());
+            continue;
+        }
+
+        row_begin.push_back(row_index.size());
+        row_bounds.emplace_back(lb, ub);
+    }
+
+    num_reduced_rows = row_bounds.size();
+
+    // The original objective function without the fixed variables.
+    vector<IloInt> obj_index;
+    vector<IloNum> obj_coef;
+    for(auto it = original_objective_per_thread[0].getLinearIterator(); it.ok(); ++it) {
+        if(fixed_value(it.getVar()) != -1)
+            continue;
+        obj_index.push_back(variables_id_index[it.getVar().getId()]);
+        obj_coef.push_back(it.getCoef());
+    }
+
+    const bool maximize = (original_objective_per_thread[0].getSense() ==
+                           IloObjective::Sense::Maximize);
+
+    // All variables but the fixed ones.
+    vector<bool> is_fixed(variables.getSize(), false);
+    for(IloInt j = 0; j < NUM_BINARIES; ++j)
+        if(fixed_vars[j] != -1)
+            is_fixed[binary_variables_indices[j]] = true;
+
+    vector<IloInt> free_variables;
+    free_variables.reserve(variables.getSize());
+    for(IloInt j = 0; j < variables.getSize(); ++j)
+        if(!is_fixed[j])
+            free_variables.push_back(j);
+
+    // Now, build and presolve the reduced model of each thread.
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(this->num_threads)
+    #endif
+    for(int t = 0; t < num_threads; ++t) {
+        auto &env = environment_per_thread[t];
+        auto &variables_t = variables_per_thread[t];
+        auto &reduced = reduced_model_per_thread[t];
+
+        reduced.model = IloModel(env);
+        reduced.rows = IloRangeArray(env);
+        reduced.binaries = IloNumVarArray(env);
+        reduced.values = IloNumArray(env, reduced_to_full.size());
+
+        for(const auto j : reduced_to_full)
+            reduced.binaries.add(binary_variables_per_thread[t][j]);
+
+        IloNumVarArray free_vars(env);
+        for(const auto j : free_variables)
+            free_vars.add(variables_t[j]);
+
+        for(size_t i = 0; i < num_reduced_rows; ++i) {
+            IloExpr expr(env);
+            for(size_t k = row_begin[i]; k < row_begin[i + 1]; ++k)
+                expr += row_coef[k] * variables_t[row_index[k]];
+
+            reduced.rows.add(IloRange(env, row_bounds[i].lb, expr, row_bounds[i].ub));
+            expr.end();
+        }
+
+        reduced.original_expr = IloExpr(env);
+        for(size_t k = 0; k < obj_index.size(); ++k)
+            reduced.original_expr += obj_coef[k] * variables_t[obj_index[k]];
+
+        IloExpr obj_expr(env);
+        obj_expr = IloSum(reduced.binaries);
+        if(maximize)
+            obj_expr -= reduced.original_expr;
+        else
+            obj_expr += reduced.original_expr;
+
+        reduced.objective = IloObjective(env, obj_expr, IloObjective::Sense::Minimize);
+        obj_expr.end();
+
+        reduced.relaxer = IloConversion(env, free_vars, IloNumVar::Float);
+
+        reduced.model.add(free_vars);
+        reduced.model.add(reduced.rows);
+        reduced.model.add(reduced.objective);
+        reduced.model.add(reduced.relaxer);
+        free_vars.end();
+
+        // Same parameters of the full projection LP.
+        reduced.cplex = IloCplex(env);
+        IloCplex::ParameterSet parameters = cplex_per_thread[t].getParameterSet();
+        reduced.cplex.setParameterSet(parameters);
+        parameters.end();
+
+        #ifndef DEBUG
+        reduced.cplex.setOut(env.getNullStream());
+        reduced.cplex.setWarning(env.getNullStream());
+        #endif
+
+        reduced.cplex.extract(reduced.model);
+
+        #ifndef NO_PRESOLVE
+        reduced.cplex.presolve(IloCplex::Algorithm::AutoAlg);
+        #endif
+    }
+
+    reduced_models_active = true;
+
+    #ifdef DEBUG
+    cout << "\n> Reduced models: " << reduced_to_full.size() << " of "
+         << NUM_BINARIES << " binaries, " << num_reduced_rows << " of "
+         << constraints_per_thread[0].getSize() << " rows" << endl;
+    #endif
+}
+
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::clearReducedModels() {
+    if(!reduced_models_active)
+        return;
+
+    detachRoundingCuts();
+
+    for(auto &reduced : reduced_model_per_thread) {
+        reduced.cplex.end();
+        reduced.model.end();
+        reduced.rows.endElements();
+        reduced.rows.end();
+        reduced.objective.end();
+        reduced.original_expr.end();
+        reduced.relaxer.end();
+        reduced.binaries.end();
+        reduced.values.end();
+    }
+
+    reduced_to_full.clear();
+    full_to_reduced.clear();
+    num_reduced_rows = 0;
+    reduced_models_active = false;
+}
+
 //----------------------------------------------------------------------------//
 // Fix Divide-and-Conquer
 //----------------------------------------------------------------------------//
@@ -1225,6 +1728,10 @@ void FeasibilityPump_Decoder::fixDivideAndConquer(const IloInt begin, const IloI
     cout << endl;
     #endif
 
+    vector<IloInt> indices;
+    vector<UpperLowerBounds> bounds;
+    vector<UpperLowerBounds> previous_bounds;
+
     for(IloInt i = begin; i < end; ++i) {
         const auto &index = to_be_fixed[i].second;
         auto &var = binary_variables[index];
@@ -1239,10 +1746,14 @@ void FeasibilityPump_Decoder::fixDivideAndConquer(const IloInt begin, const IloI
             // more than 50% of the chromosomes, fix to 1.0. If not, fix to 0.0.
             const auto value_to_be_fixed =
                 (histogram[index] >= threshold)? 1.0 : 0.0;
-            var.setBounds(value_to_be_fixed, value_to_be_fixed);
+            indices.push_back(index);
+            bounds.emplace_back(value_to_be_fixed, value_to_be_fixed);
+            previous_bounds.push_back(old_bounds[index]);
         }
     }
 
+    setBinaryBounds(indices, bounds, 0);
+
     // Check if this fixing of this block of variables is feasible.
     // NOTE: Yes, I know that this try/catch construction is horrible
     // slow! But, this is the unique way, AFAIK, to deal with the
@@ -1263,11 +1774,7 @@ void FeasibilityPump_Decoder::fixDivideAndConquer(const IloInt begin, const IloI
         #endif
 
         // Restore the old bounds and recurse.
-        for(IloInt i = begin; i < end; ++i) {
-            const auto &index = to_be_fixed[i].second;
-            binary_variables[index].setBounds(old_bounds[index].lb,
-                                              old_bounds[index].ub);
-        }
+        setBinaryBounds(indices, previous_bounds, 0);
         recurse = true;
     }
 
@@ -1333,6 +1840,10 @@ void FeasibilityPump_Decoder::fixPerBlocks(const IloInt begin, const IloInt end,
     cout << endl;
     #endif
 
+    vector<IloInt> indices;
+    vector<UpperLowerBounds> bounds;
+    vector<UpperLowerBounds> previous_bounds;
+
     auto begin_block = begin;
     while(begin_block != end) {
         auto end_block = begin_block + BLOCK_SIZE;
@@ -1340,6 +1851,10 @@ void FeasibilityPump_Decoder::fixPerBlocks(const IloInt begin, const IloInt end,
         if(end_block > end)
             end_block = end;
 
+        indices.clear();
+        bounds.clear();
+        previous_bounds.clear();
+
         for(IloInt i = begin_block; i < end_block; ++i) {
             const auto &index = to_be_fixed[i].second;
             auto &var = binary_variables[index];
@@ -1354,10 +1869,14 @@ void FeasibilityPump_Decoder::fixPerBlocks(const IloInt begin, const IloInt end,
                 // more than 50% of the chromosomes, fix to 1.0. If not, fix to 0.0.
                 const auto value_to_be_fixed =
                     (histogram[index] >= threshold)? 1.0 : 0.0;
-                var.setBounds(value_to_be_fixed, value_to_be_fixed);
+                indices.push_back(index);
+                bounds.emplace_back(value_to_be_fixed, value_to_be_fixed);
+                previous_bounds.push_back(old_bounds[index]);
             }
         }
 
+        setBinaryBounds(indices, bounds, 0);
+
         // Check if this fixing of this block of variables is feasible.
         // NOTE: Yes, I know that this try/catch construction is horrible
         // slow! But, this is the unique way, AFAIK, to deal with the
@@ -1377,11 +1896,7 @@ void FeasibilityPump_Decoder::fixPerBlocks(const IloInt begin, const IloInt end,
             #endif
 
             // Restore the old bounds and fix one-by-one
-            for(IloInt i = begin_block; i < end_block; ++i) {
-                const auto &index = to_be_fixed[i].second;
-                binary_variables[index].setBounds(old_bounds[index].lb,
-                                                  old_bounds[index].ub);
-            }
+            setBinaryBounds(indices, previous_bounds, 0);
             one_by_one = true;
         }
 
@@ -1457,147 +1972,339 @@ void FeasibilityPump_Decoder::addCutsFromRoudings(const Population& population,
         throw runtime_error(ss.str());
     }
 
-    // First, we undo the previous variable fixing
     const auto NUM_BINARIES = binary_variables_per_thread[0].getSize();
 
-    vector<IloExpr> exps_per_thread(num_threads);
-
     for(unsigned i = 0; i < num_cuts; ++i) {
         const auto &chr = population.getChromosome(i);
 
-        #ifdef FULLDEBUG
-        IloExpr tmp(environment_per_thread[0]);
-        int accum_tmp = 0;
-        for(IloInt j = 0; j < NUM_BINARIES; ++j) {
-            if(chr.rounded[j] == 1) {
-                tmp += binary_variables_per_thread[0][j];
-            }
-            else {
-                tmp -= binary_variables_per_thread[0][j];
-                ++accum_tmp;
-            }
-        }
-        cout << "\n\n- Trying cut " << IloConstraint(tmp <= NUM_BINARIES - 1 - accum_tmp);
-        cout.flush();
-        tmp.end();
-        #endif
+        // The cut sum_{r_j = 1} x_j - sum_{r_j = 0} x_j <= |{j : r_j = 1}| - 1
+        // over the indices of the binaries.
+        dominiqs::CutPtr cut(new dominiqs::Cut());
+        cut->row.reserve(NUM_BINARIES);
+        cut->sense = 'L';
 
         // Hashing the rounding
         size_t hash_value = 0;
-        for(size_t k = 0; k < (size_t)NUM_BINARIES; ++k) {
-            if(chr.rounded[k] == 1)
-                hash_value ^= k + 0x9e3779b9 + (hash_value << 6) + (hash_value >> 2);
-        }
-
-        if(rounding_cuts.find(hash_value) != rounding_cuts.end()) {
-            #ifdef FULLDEBUG
-            cout << "\n- Already taken. Skipped"; cout.flush();
-            #endif
-            continue;
-        }
-
-        for(int t = 0; t < num_threads; ++t)
-            exps_per_thread[t] = IloExpr(environment_per_thread[t]);
-
-        int accum = 0;
+        int num_ones = 0;
         for(IloInt j = 0; j < NUM_BINARIES; ++j) {
             if(chr.rounded[j] == 1) {
-                for(int t = 0; t < num_threads; ++t)
-                    exps_per_thread[t] += binary_variables_per_thread[t][j];
+                cut->row.push_unsafe(j, 1.0);
+                ++num_ones;
+                hash_value ^= (size_t)j + 0x9e3779b9 +
+                              (hash_value << 6) + (hash_value >> 2);
             }
             else {
-                for(int t = 0; t < num_threads; ++t)
-                    exps_per_thread[t] -= binary_variables_per_thread[t][j];
-                ++accum;
+                cut->row.push_unsafe(j, -1.0);
             }
         }
+        cut->rhs = num_ones - 1;
 
-        for(int t = 0; t < num_threads; ++t)
-            cuts_per_thread[t].add(exps_per_thread[t] <= NUM_BINARIES - 1 - accum);
-
-        rounding_cuts[hash_value] = cuts_per_thread[0][cuts_per_thread[0].getSize() - 1];
+        // All cuts have the same support, and so, the same signature given
+        // by digest(). We use the hash of the rounding instead.
+        cut->digest();
+        cut->sig = hash_value;
 
-        for(auto &expr : exps_per_thread)
-            expr.end();
+        #ifdef FULLDEBUG
+        cout << "\n\n- Trying cut with " << num_ones << " ones";
+        if(!rounding_cut_pool.push(cut))
+            cout << "\n- Already taken. Skipped";
+        cout.flush();
+        #else
+        rounding_cut_pool.push(cut);
+        #endif
     }
 
-    // Adding the cuts.
-    for(int t = 0; t < num_threads; ++t) {
-        model_per_thread[t].add(cuts_per_thread[t]);
-        cuts_per_thread[t].clear();
+    // Age the cuts not attached to any LP. Note that the attached cuts are
+    // aged by each thread, at each projection.
+    unordered_set<const dominiqs::Cut*> attached;
+    for(const auto &attached_cuts : attached_cuts_per_thread)
+        for(const auto &attached_cut : attached_cuts)
+            attached.insert(attached_cut.cut);
+
+    for(const auto &cut : rounding_cut_pool) {
+        cut->inUse = (attached.find(cut.get()) != attached.end());
+        if(cut->inUse)
+            cut->age = 0;
+        else if(cut->age < numeric_limits<uint8_t>::max())
+            ++cut->age;
     }
 
+    // Purge the pool against the last LP solution of the first thread, and
+    // remove the purged cuts from the LPs.
+    const auto &current_values = current_values_per_thread[0];
+    vector<double> point(NUM_BINARIES);
+    for(IloInt j = 0; j < NUM_BINARIES; ++j)
+        point[j] = current_values[j];
+
+    size_t num_purged = 0;
+    int purged;
+    while((purged = rounding_cut_pool.purge(point)) > 0)
+        num_purged += purged;
+
+    if(num_purged > 0)
+        detachRoundingCuts(true);
+
     #ifdef DEBUG
-    cout << "\n--------------------------------\n" << endl;
+    cout << "\n> Rounding cut pool: " << rounding_cut_pool.size() << " cuts, "
+         << (rounding_cut_pool.memoryUsed() / 1024.0) << " KB, "
+         << num_purged << " purged"
+         << "\n--------------------------------\n" << endl;
     #endif
 }
 
 //----------------------------------------------------------------------------//
-// Perform MIP Local Search
+// Rounding cut pool
 //----------------------------------------------------------------------------//
 
-// Call when find a feasible solution.
-ILOINCUMBENTCALLBACK0(StopWhenFindFeasibleCallback) {
-    if(hasIncumbent() || ExecutionStopper::mustStop())
-        abort();
+void FeasibilityPump_Decoder::setRoundingCutLimits(const unsigned max_pool_cuts,
+                                                   const double max_pool_memory,
+                                                   const unsigned max_attached,
+                                                   const unsigned max_slack_age) {
+    if(max_pool_cuts == 0 || max_pool_memory <= 0.0)
+        throw runtime_error("The rounding cut pool limits must be positive.");
+
+    rounding_cut_pool.maxSize = max_pool_cuts;
+    rounding_cut_pool.maxMemory = max_pool_memory;
+    max_attached_cuts = max_attached;
+    max_cut_slack_age = max_slack_age;
 }
 
-ILOMIPINFOCALLBACK0(StopCtrlCorTimeCallback) {
-    if(ExecutionStopper::mustStop())
-        abort();
+//----------------------------------------------------------------------------//
+
+size_t FeasibilityPump_Decoder::getNumProjectionRows(const int thread) const {
+    return (reduced_models_active? num_reduced_rows :
+                                   (size_t)constraints_per_thread[thread].getSize()) +
+           attached_cuts_per_thread[thread].size();
 }
 
-bool FeasibilityPump_Decoder::performMIPLocalSearch(
-        const Population& population, const unsigned num_chromosomes,
-        const unsigned unfix_level, const double max_time,
-        Chromosome& possible_feasible, size_t& num_unfixed_vars) {
+//----------------------------------------------------------------------------//
 
-    #ifdef DEBUG
-    cout << "\n------------------------------------------------------\n"
-         << "> Performing MIP local search (time: "
-         << setiosflags(ios::fixed)
-         << setprecision(2)
-         << max_time << ")"
-         << endl;
-    #endif
+// The rounding cuts can be written as sum_{r_j = 1} (1 - x_j) +
+// sum_{r_j = 0} x_j >= 1, i.e., the L1 distance between x and the rounding
+// must be at least one. This function computes the distance, but stops
+// as soon as it reaches the limit.
+static double roundingCutDistance(const dominiqs::Cut& cut,
+                                  const IloNumArray& values,
+                                  const double limit) {
+    const int *index = cut.row.idx();
+    const double *coef = cut.row.coef();
+    const auto size = cut.row.size();
+
+    double distance = 0.0;
+    for(decltype(cut.row.size()) k = 0; k < size && distance < limit; ++k) {
+        const double value = values[index[k]];
+        distance += (coef[k] > 0.0)? 1.0 - value : value;
+    }
+    return distance;
+}
 
-    auto &env = environment_per_thread[0];
-    auto &cplex = cplex_per_thread[0];
-    auto &model = model_per_thread[0];
-    auto &binary_variables = binary_variables_per_thread[0];
-    auto &constraints = constraints_per_thread[0];
-    auto &relaxer = relaxer_per_thread[0];
-    auto &original_objective = original_objective_per_thread[0];
+//----------------------------------------------------------------------------//
+
+bool FeasibilityPump_Decoder::separateRoundingCuts(const int thread,
+                                                   const IloNumArray& values,
+                                                   const bool age_cuts) {
+    auto &attached_cuts = attached_cuts_per_thread[thread];
+    IloModel &lp_model = reduced_models_active?
+                         reduced_model_per_thread[thread].model :
+                         model_per_thread[thread];
+
+    // As in dominiqs::CutPool, a cut is violated (slack) if its violation
+    // divided by its norm is above (below) minEfficacy (-minEfficacy).
+    const double min_efficacy = rounding_cut_pool.minEfficacy;
+
+    // First, remove the cuts slack for a long time.
+    if(age_cuts) {
+        size_t last = 0;
+        for(size_t i = 0; i < attached_cuts.size(); ++i) {
+            auto &attached_cut = attached_cuts[i];
+            const double limit = 1.0 + min_efficacy * attached_cut.cut->norm;
+            if(roundingCutDistance(*attached_cut.cut, values, limit) > limit)
+                ++attached_cut.slack_age;
+            else
+                attached_cut.slack_age = 0;
+
+            if(attached_cut.slack_age > max_cut_slack_age) {
+                lp_model.remove(attached_cut.range);
+                attached_cut.range.end();
+            }
+            else {
+                attached_cuts[last++] = attached_cut;
+            }
+        }
+        attached_cuts.resize(last);
+    }
+
+    if(attached_cuts.size() >= max_attached_cuts)
+        return false;
+
+    // Now, look for the violated cuts not attached yet.
+    unordered_set<const dominiqs::Cut*> attached;
+    for(const auto &attached_cut : attached_cuts)
+        attached.insert(attached_cut.cut);
+
+    vector<pair<double, const dominiqs::Cut*>> violated;
+    for(const auto &cut : rounding_cut_pool) {
+        if(attached.find(cut.get()) != attached.end())
+            continue;
+
+        const double limit = 1.0 - min_efficacy * cut->norm;
+        const double distance = roundingCutDistance(*cut, values, limit);
+        if(distance < limit)
+            violated.emplace_back(distance, cut.get());
+    }
+
+    if(violated.empty())
+        return false;
+
+    // Attach the most violated ones.
+    const size_t num_to_attach = min(violated.size(),
+                                     max_attached_cuts - attached_cuts.size());
+    partial_sort(violated.begin(), violated.begin() + num_to_attach,
+                 violated.end());
+
+    for(size_t i = 0; i < num_to_attach; ++i) {
+        IloRange range = buildRoundingCut(thread, *violated[i].second);
+        lp_model.add(range);
+        attached_cuts.emplace_back(violated[i].second, range);
+    }
+
+    #ifdef FULLDEBUG
+    cout << "\n- Thread " << thread << ": attached " << num_to_attach
+         << " rounding cuts (" << attached_cuts.size() << " in the LP)";
+    cout.flush();
+    #endif
+
+    return true;
+}
+
+//----------------------------------------------------------------------------//
+
+IloRange FeasibilityPump_Decoder::buildRoundingCut(const int thread,
+                                                   const dominiqs::Cut& cut) {
+    auto &env = environment_per_thread[thread];
+    const int *index = cut.row.idx();
+    const double *coef = cut.row.coef();
+
+    IloExpr expr(env);
+    IloNum rhs = cut.rhs;
+
+    if(reduced_models_active) {
+        // Move the fixed variables to the right hand side.
+        const auto &binaries = reduced_model_per_thread[thread].binaries;
+        for(decltype(cut.row.size()) k = 0; k < cut.row.size(); ++k) {
+            const IloInt reduced_index = full_to_reduced[index[k]];
+            if(reduced_index == -1)
+                rhs -= coef[k] * fixed_vars[index[k]];
+            else
+                expr += coef[k] * binaries[reduced_index];
+        }
+    }
+    else {
+        const auto &binaries = binary_variables_per_thread[thread];
+        for(decltype(cut.row.size()) k = 0; k < cut.row.size(); ++k)
+            expr += coef[k] * binaries[index[k]];
+    }
+
+    IloRange range(env, -IloInfinity, expr, rhs);
+    expr.end();
+    return range;
+}
+
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::detachRoundingCuts(const bool only_purged) {
+    unordered_set<const dominiqs::Cut*> in_pool;
+    if(only_purged)
+        for(const auto &cut : rounding_cut_pool)
+            in_pool.insert(cut.get());
+
+    for(int t = 0; t < num_threads; ++t) {
+        auto &attached_cuts = attached_cuts_per_thread[t];
+        IloModel &lp_model = reduced_models_active?
+                             reduced_model_per_thread[t].model :
+                             model_per_thread[t];
+
+        size_t last = 0;
+        for(size_t i = 0; i < attached_cuts.size(); ++i) {
+            // Note that a purged cut is not dereferenced here.
+            if(only_purged &&
+               in_pool.find(attached_cuts[i].cut) != in_pool.end()) {
+                attached_cuts[last++] = attached_cuts[i];
+                continue;
+            }
+            lp_model.remove(attached_cuts[i].range);
+            attached_cuts[i].range.end();
+        }
+        attached_cuts.resize(last);
+    }
+}
+
+//----------------------------------------------------------------------------//
+// Perform MIP Local Search
+//----------------------------------------------------------------------------//
+
+// Call when find a feasible solution. It also records where the first
+// incumbent came from.
+ILOINCUMBENTCALLBACK2(StopWhenFindFeasibleCallback,
+                      const FeasibilityPump_Decoder*, decoder,
+                      int*, first_source) {
+    if(!hasIncumbent() && *first_source == -1)
+        *first_source = int(getSolutionSource());
+
+    if(hasIncumbent() || decoder->mustStopMIPLocalSearch())
+        abort();
+}
+
+bool FeasibilityPump_Decoder::performMIPLocalSearch(
+        const Population& population, const unsigned num_chromosomes,
+        const unsigned unfix_level, const double max_time,
+        Chromosome& possible_feasible, size_t& num_unfixed_vars) {
+
+    #ifdef DEBUG
+    cout << "\n------------------------------------------------------\n"
+         << "> Performing MIP local search (time: "
+         << setiosflags(ios::fixed)
+         << setprecision(2)
+         << max_time << ")"
+         << endl;
+    #endif
+
+    collectEliteRoundings(population, num_chromosomes);
+
+    if(!mip_local_search_portfolio.empty())
+        return racePortfolio(population, num_chromosomes, max_time,
+                             possible_feasible, num_unfixed_vars);
+
+    portfolio_winner = -1;
+
+    auto &env = environment_per_thread[0];
+    auto &cplex = cplex_per_thread[0];
+    auto &model = model_per_thread[0];
+    auto &binary_variables = binary_variables_per_thread[0];
+    auto &constraints = constraints_per_thread[0];
+    auto &relaxer = relaxer_per_thread[0];
+    auto &original_objective = original_objective_per_thread[0];
     auto &fp_objective = fp_objective_per_thread[0];
 
     const auto NUM_BINARIES = binary_variables.getSize();
     size_t num_fixed_vars = 0;
 
-    // Now, build the histogram.
-    vector<int> histogram(NUM_BINARIES, 0);
+    // Now, take the histogram (kept by the population).
+    const vector<int> &histogram = population.getEliteHistogram(num_chromosomes);
 
     // Indicate if the variable is fixed to 0, 1, or is free (-1).
     vector<int8_t> local_fixed(NUM_BINARIES, -1);
 
-    for(unsigned i = 0; i < num_chromosomes; ++i) {
-        auto &chr = population.getChromosome(i);
-        for(IloInt j = 0; j < NUM_BINARIES; ++j)
-            histogram[j] += chr.rounded[j];
-    }
-
     for(IloInt var_idx = 0; var_idx < NUM_BINARIES; ++var_idx) {
         auto value = histogram[var_idx] / (double) num_chromosomes;
         if(value < (discrepancy_level + EPS) || value > (1- discrepancy_level - EPS)) {
-            value = round(value);
-            binary_variables[var_idx].setBounds(value, value);
-            local_fixed[var_idx] = int8_t(value);
+            local_fixed[var_idx] = int8_t(round(value));
             ++num_fixed_vars;
         }
-        else
-            binary_variables[var_idx].setBounds(binary_variables_bounds[var_idx].lb,
-                                                binary_variables_bounds[var_idx].ub);
     }
 
+    setBinaryFixing(local_fixed, 0);
+
     num_unfixed_vars = NUM_BINARIES - num_fixed_vars;
 
     #ifdef DEBUG
@@ -1617,143 +2324,70 @@ bool FeasibilityPump_Decoder::performMIPLocalSearch(
     // Checking violated constraints.
     /////////////////////////////////
 
+    const auto &matrix = constraint_matrix;
+
+    // All rows are evaluated at once against the current fixing. Since
+    // unfixing only relaxes the rows, the sequential pass below needs to
+    // check again only these candidates.
+    vector<uint8_t> candidates;
+    findViolatedRows(local_fixed, candidates);
+
     for(IloInt i = 0; i < constraints.getSize(); ++i) {
-        if(ExecutionStopper::mustStop())
+        if(mustStopMIPLocalSearch())
             break;
 
-        auto &ctr = constraints[i];
-        IloNum fixed_contribution = 0.0;
-        IloNum positive_contribution = 0.0;
-        IloNum negative_contribution = 0.0;
+        if(!candidates[i])
+            continue;
 
         size_t hash_value = 0;  // Used to identify cut already taken
 
-        for(auto it = ctr.getLinearIterator(); it.ok(); ++it) {
-            auto var = it.getVar();
-            auto value = it.getCoef();
-
-            if(var.getType() == IloNumVar::Bool) {
-                const auto var_index = binary_variables_id_index[var.getId()];
-
-                if(local_fixed[var_index] == 1) {
-                    fixed_contribution += value;
-                    hash_value ^= (size_t)var_index + 0x9e3779b9 +
-                                  (hash_value << 6) + (hash_value >> 2);
-                }
-                else
-                if(local_fixed[var_index] == -1) {
-                    if(value > 0)
-                        positive_contribution += value;
-                    else
-                        negative_contribution += value;
-                }
-            }
-            else {
-                if(value > 0)
-                    positive_contribution += value;
-                else
-                    negative_contribution += value;
-            }
-        }
-
-        // Let's check for violation in each type of constraint
-        char constraint_type;
-
-        // <= inequalities
-        if(ctr.getLB() == -IloInfinity && ctr.getUB() < IloInfinity) {
-            constraint_type = 'l';
-        }
-        // >= inequalities
-        else if(ctr.getLB() > -IloInfinity && ctr.getUB() == IloInfinity) {
-            constraint_type = 'g';
-        }
-        // equalities
-        else if(fabs(ctr.getUB() - ctr.getLB()) < EPS) {
-            constraint_type = 'e';
-        }
-        // Oops, this constraint is a range and we will not handle that for now.
-        else {
-            stringstream ss;
-            ss << "performIteratedMIPLocalSearch: found a strange constraint: "
-               << ctr;
-            throw runtime_error(ss.str());
-        }
-
-        // First <= inequalities
-        bool violated = (constraint_type == 'l') &&
-                        (fixed_contribution + negative_contribution > ctr.getUB());
-
-        // Now >= inequalities
-        if(!violated && constraint_type == 'g')
-            violated = fixed_contribution + positive_contribution < ctr.getLB();
-
-        // Finally, = equalities
-        if(!violated && constraint_type == 'e') {
-            auto surplus = fixed_contribution - ctr.getUB();
-            violated = surplus < 0? (surplus + positive_contribution < 0) :
-                                    (surplus + negative_contribution > 0);
-        }
-
-        #ifdef FULLDEBUG
-        cout << "\n** " << ctr
-             << "\n> ctr.getLB: " << ctr.getLB()
-             << "\n> ctr.getUB: " << ctr.getUB()
-             << "\n- fixed_contribution: " << fixed_contribution
-             << "\n- positive_contribution: " << positive_contribution
-             << "\n- negative_contribution: " << negative_contribution
-             << "\n violated: " << (violated? "yes" : "no")
-             << endl;
-        #endif
-
-        if(!violated)
+        if(!isViolatedByFixing(i, local_fixed, hash_value))
             continue;
 
+        const char constraint_type = matrix.type[i];
+
         // If violated, create a cutting plane.
-        if(rounding_cuts.find(hash_value) == rounding_cuts.end()) {
+        if(local_search_cuts.find(hash_value) == local_search_cuts.end()) {
             IloExpr expr(env);
             int accum = 0;
 
-            for(auto it = ctr.getLinearIterator(); it.ok(); ++it) {
-                auto var = it.getVar();
-                if(var.getType() != IloNumVar::Bool)
-                    continue;
-
-                const auto var_index = binary_variables_id_index[var.getId()];
+            for(size_t k = matrix.row_begin[i]; k < matrix.row_begin[i + 1]; ++k) {
+                const auto var_index = matrix.index[k];
                 if(local_fixed[var_index] == 0) {
-                    expr -= var;
+                    expr -= binary_variables[var_index];
                 }
                 else if(local_fixed[var_index] == 1) {
-                    expr += var;
+                    expr += binary_variables[var_index];
                     ++accum;
                 }
             }
 
             IloConstraint cut(expr <= accum - 1);
-            rounding_cuts[hash_value] = cut;
+            local_search_cuts[hash_value] = cut;
             cplex.addLazyConstraint(cut);
 
             expr.end();
         }
 
         /// Unfix the variables of this constraint.
-        for(auto it = ctr.getLinearIterator(); it.ok(); ++it) {
-            auto var = it.getVar();
-            auto coef = it.getCoef();
+        for(size_t k = matrix.row_begin[i]; k < matrix.row_begin[i + 1]; ++k) {
+            const auto var_index = matrix.index[k];
+            const auto coef = matrix.coef[k];
+            auto var = binary_variables[var_index];
 
             // If the violated constraint is <= and the constraint coefficient
             // is < 0, then free the variable only if its current value is 0;
             // if the constraint coefficient is > 0, the free only if the
             // current value is 1, opposite for >= constraints.
-            if(var.getType() == IloNumVar::Bool &&
-               !(var.getLB() < EPS && var.getUB() > 1 - EPS) &&
+            if(!(var.getLB() < EPS && var.getUB() > 1 - EPS) &&
                ((constraint_type == 'e') ||
-                (local_fixed[binary_variables_id_index[var.getId()]] == 0 &&
+                (local_fixed[var_index] == 0 &&
                  ((constraint_type == 'l' && coef < 0.0) ||
                   (constraint_type == 'g' && coef > 0.0))
                ))) {
                 var.setBounds(0, 1);
                 ++num_unfixed_vars;
-                local_fixed[binary_variables_id_index[var.getId()]] = -1;
+                local_fixed[var_index] = -1;
             }
         }
     }
@@ -1789,15 +2423,42 @@ bool FeasibilityPump_Decoder::performMIPLocalSearch(
     cplex.setParam(IloCplex::Param::MIP::Display, 4);
     #endif
 
-    auto stop_when_find_feasible_callback = StopWhenFindFeasibleCallback(env);
-    auto stop_ctrl_c_or_time_callback = StopCtrlCorTimeCallback(env);
+    int first_source = -1;
+    auto stop_when_find_feasible_callback =
+            StopWhenFindFeasibleCallback(env, this, &first_source);
+    auto stop_ctrl_c_or_time_callback = StopCtrlCorTimeCallback(env, this);
     cplex.use(stop_when_find_feasible_callback);
     cplex.use(stop_ctrl_c_or_time_callback);
 
     bool solution_found = false;
     feasible_before_var_unfixing = true;
 
-    cplex.solve();
+    // Solve the parts of the neighbourhood concurrently. If they do not
+    // give a feasible solution, the global sub-MIP below takes care of
+    // the remaining conflicts.
+    bool solved_by_parts = false;
+    num_subproblems = 0;
+    num_feasible_subproblems = 0;
+
+    if(mip_local_search_decomposition != DecompositionType::NONE &&
+       num_threads > 1 && !mustStopMIPLocalSearch()) {
+        boost::timer::cpu_timer decomposition_timer;
+
+        solved_by_parts = performDecomposedMIPLocalSearch(max_time / 2.0,
+                                                          local_fixed,
+                                                          num_unfixed_vars);
+
+        const double elapsed = decomposition_timer.elapsed().wall / 1e9;
+        cplex.setParam(IloCplex::Param::TimeLimit, max(max_time - elapsed, 1.0));
+    }
+
+    // The starts are given after the decomposition since it may fix
+    // some free variables.
+    int num_starts = 0;
+    if(!solved_by_parts) {
+        num_starts = addEliteMIPStarts(0, local_fixed);
+        cplex.solve();
+    }
 
     #ifdef DEBUG
     cout << "\n** CPLEX status after first fix/unfix: " << cplex.getStatus()
@@ -1805,7 +2466,7 @@ bool FeasibilityPump_Decoder::performMIPLocalSearch(
     #endif
 
     // If fails, add a cut and unfix more variables.
-    if(cplex.getStatus() == IloAlgorithm::Infeasible && !ExecutionStopper::mustStop()) {
+    if(cplex.getStatus() == IloAlgorithm::Infeasible && !mustStopMIPLocalSearch()) {
         feasible_before_var_unfixing = false;
 
         // First, we insert a general cut.
@@ -1825,9 +2486,9 @@ bool FeasibilityPump_Decoder::performMIPLocalSearch(
             }
         }
 
-        if(rounding_cuts.find(hash_value) == rounding_cuts.end()) {
+        if(local_search_cuts.find(hash_value) == local_search_cuts.end()) {
             IloConstraint cut(expr <= accum - 1);
-            rounding_cuts[hash_value] = cut;
+            local_search_cuts[hash_value] = cut;
             cplex.addLazyConstraint(cut);
         }
 
@@ -1836,20 +2497,18 @@ bool FeasibilityPump_Decoder::performMIPLocalSearch(
         // Now, we unfix variables.
         vector<IloInt> vars_to_unfix_current;
         vector<IloInt> vars_to_unfix_next;
-        unordered_set<IloInt> taken_vars;
-        unordered_set<IloInt> taken_constraints;
+        boost::dynamic_bitset<> taken_vars(NUM_BINARIES);
+        boost::dynamic_bitset<> taken_constraints(constraints.getSize());
 
         vars_to_unfix_current.reserve(NUM_BINARIES / 2);
         vars_to_unfix_next.reserve(NUM_BINARIES / 2);
-        taken_vars.reserve(NUM_BINARIES / 2);
-        taken_constraints.reserve(constraints.getSize());
 
         for(IloInt i = 0; i < NUM_BINARIES; ++i) {
             if(local_fixed[i] != -1)
                 continue;
 
-            vars_to_unfix_current.push_back(binary_variables[i].getId());
-            taken_vars.insert(binary_variables[i].getId());
+            vars_to_unfix_current.push_back(i);
+            taken_vars.set(i);
         }
 
         for(unsigned iteration = 0; iteration < unfix_level &&
@@ -1862,28 +2521,28 @@ bool FeasibilityPump_Decoder::performMIPLocalSearch(
 
             vars_to_unfix_next.clear();
 
-            for(auto &var_id : vars_to_unfix_current) {
-                for(auto &ctr : constraints_per_variable[binary_variables_id_index[var_id]]) {
-                    if(taken_constraints.find(ctr.getId()) != taken_constraints.end())
+            for(auto &var_index : vars_to_unfix_current) {
+                for(size_t p = matrix.column_begin[var_index];
+                    p < matrix.column_begin[var_index + 1]; ++p) {
+                    const auto row = matrix.rows[p];
+                    if(taken_constraints.test(row))
                         continue;
 
-                    taken_constraints.insert(ctr.getId());
+                    taken_constraints.set(row);
 
-                    for(auto it = ctr.getLinearIterator(); it.ok(); ++it) {
-                        if(ExecutionStopper::mustStop())
-                            // NOTE: I know, it's horrible but the best solution here.
-                            goto after_unfix;
+                    if(mustStopMIPLocalSearch())
+                        // NOTE: I know, it's horrible but the best solution here.
+                        goto after_unfix;
 
-                        auto var = it.getVar();
-                        if(taken_vars.find(var.getId()) != taken_vars.end())
+                    for(size_t k = matrix.row_begin[row]; k < matrix.row_begin[row + 1]; ++k) {
+                        const auto index = matrix.index[k];
+                        if(taken_vars.test(index))
                             continue;
 
-                        if(var.getType() == IloNumVar::Bool) {
-                            var.setBounds(0, 1);
-                            taken_vars.insert(var.getId());
-                            vars_to_unfix_next.push_back(var.getId());
-                            ++num_unfixed_vars;
-                        }
+                        binary_variables[index].setBounds(0, 1);
+                        taken_vars.set(index);
+                        vars_to_unfix_next.push_back(index);
+                        ++num_unfixed_vars;
                     }
                 }
             }
@@ -1943,14 +2602,10 @@ bool FeasibilityPump_Decoder::performMIPLocalSearch(
         feasible_before_var_unfixing = false;
     }
 
+    accountMIPStarts(0, local_fixed, num_starts, first_source, solution_found);
+
     // Add back the FP obj. function and the relaxation transformation.
-    for(IloInt j = 0; j < NUM_BINARIES; ++j) {
-        if(fixed_vars[j] == -1)
-            binary_variables[j].setBounds(binary_variables_bounds[j].lb,
-                                          binary_variables_bounds[j].ub);
-        else
-            binary_variables[j].setBounds(fixed_vars[j], fixed_vars[j]);
-    }
+    setBinaryFixing(fixed_vars, 0);
 
     model.remove(original_objective);
     model.add(fp_objective);
@@ -1967,3 +2622,757 @@ bool FeasibilityPump_Decoder::performMIPLocalSearch(
     #endif
     return solution_found;
 }
+
+//----------------------------------------------------------------------------//
+// Neighbourhood helpers
+//----------------------------------------------------------------------------//
+
+// Check if the activity range of a row misses its bounds, given the
+// contribution of the variables fixed to one and the positive and negative
+// contributions of the free variables.
+static inline bool activityViolates(const char constraint_type,
+                                    const double lb, const double ub,
+                                    const double fixed_contribution,
+                                    const double positive_contribution,
+                                    const double negative_contribution) {
+    switch(constraint_type) {
+    // <= inequalities
+    case 'l':
+        return fixed_contribution + negative_contribution > ub;
+
+    // >= inequalities
+    case 'g':
+        return fixed_contribution + positive_contribution < lb;
+
+    // = equalities
+    case 'e': {
+        const double surplus = fixed_contribution - ub;
+        return surplus < 0? (surplus + positive_contribution < 0) :
+                            (surplus + negative_contribution > 0);
+    }
+
+    default:
+        return false;
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+bool FeasibilityPump_Decoder::isViolatedByFixing(const size_t row,
+        const vector<int8_t>& local_fixed, size_t& hash_value) const {
+
+    const auto &matrix = constraint_matrix;
+
+    // Oops, this constraint is a range and we will not handle that for now.
+    if(matrix.type[row] == 'r') {
+        stringstream ss;
+        ss << "isViolatedByFixing: found a strange constraint: "
+           << constraints_per_thread[0][row];
+        throw runtime_error(ss.str());
+    }
+
+    double fixed_contribution = 0.0;
+    double positive_contribution = matrix.other_positive[row];
+    double negative_contribution = matrix.other_negative[row];
+
+    for(size_t k = matrix.row_begin[row]; k < matrix.row_begin[row + 1]; ++k) {
+        const auto var_index = matrix.index[k];
+        const auto value = matrix.coef[k];
+
+        if(local_fixed[var_index] == 1) {
+            fixed_contribution += value;
+            hash_value ^= (size_t)var_index + 0x9e3779b9 +
+                          (hash_value << 6) + (hash_value >> 2);
+        }
+        else
+        if(local_fixed[var_index] == -1) {
+            if(value > 0)
+                positive_contribution += value;
+            else
+                negative_contribution += value;
+        }
+    }
+
+    const bool violated = activityViolates(matrix.type[row],
+                                           matrix.bounds[row].lb,
+                                           matrix.bounds[row].ub,
+                                           fixed_contribution,
+                                           positive_contribution,
+                                           negative_contribution);
+
+    #ifdef FULLDEBUG
+    cout << "\n** " << constraints_per_thread[0][row]
+         << "\n> ctr.getLB: " << matrix.bounds[row].lb
+         << "\n> ctr.getUB: " << matrix.bounds[row].ub
+         << "\n- fixed_contribution: " << fixed_contribution
+         << "\n- positive_contribution: " << positive_contribution
+         << "\n- negative_contribution: " << negative_contribution
+         << "\n violated: " << (violated? "yes" : "no")
+         << endl;
+    #endif
+
+    return violated;
+}
+
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::findViolatedRows(const vector<int8_t>& local_fixed,
+                                               vector<uint8_t>& candidates) const {
+    const auto &matrix = constraint_matrix;
+    const long num_rows = (long)matrix.type.size();
+
+    const int *const index = matrix.index.data();
+    const double *const coef = matrix.coef.data();
+    const int8_t *const fixing = local_fixed.data();
+
+    candidates.assign(num_rows, 0);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 256)
+    #endif
+    for(long row = 0; row < num_rows; ++row) {
+        // The ranges are reported, and rejected by isViolatedByFixing().
+        if(matrix.type[row] == 'r') {
+            candidates[row] = 1;
+            continue;
+        }
+
+        const long begin = (long)matrix.row_begin[row];
+        const long end = (long)matrix.row_begin[row + 1];
+
+        double fixed_contribution = 0.0;
+        double positive_contribution = 0.0;
+        double negative_contribution = 0.0;
+
+        // Branchless, so the loop is vectorized.
+        #if defined(_OPENMP) && _OPENMP >= 201307
+        #pragma omp simd reduction(+:fixed_contribution, positive_contribution, negative_contribution)
+        #endif
+        for(long k = begin; k < end; ++k) {
+            const double value = coef[k];
+            const double free_value = (fixing[index[k]] == -1)? value : 0.0;
+            fixed_contribution += (fixing[index[k]] == 1)? value : 0.0;
+            positive_contribution += std::max(free_value, 0.0);
+            negative_contribution += std::min(free_value, 0.0);
+        }
+
+        candidates[row] = activityViolates(matrix.type[row],
+                                  matrix.bounds[row].lb, matrix.bounds[row].ub,
+                                  fixed_contribution,
+                                  positive_contribution + matrix.other_positive[row],
+                                  negative_contribution + matrix.other_negative[row]);
+    }
+}
+
+//----------------------------------------------------------------------------//
+// Decomposed MIP Local Search
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::setMIPLocalSearchDecomposition(
+        const DecompositionType type, const vector<vector<size_t>>& clusters) {
+
+    if(type == DecompositionType::CLUSTERS && clusters.empty())
+        throw runtime_error("The cluster decomposition needs the variable clusters.");
+
+    mip_local_search_decomposition = type;
+    cluster_per_binary.clear();
+
+    if(type != DecompositionType::CLUSTERS)
+        return;
+
+    cluster_per_binary.resize(binary_variables_per_thread[0].getSize(), -1);
+    for(size_t c = 0; c < clusters.size(); ++c) {
+        for(const auto &var_index : clusters[c]) {
+            if(var_index >= cluster_per_binary.size())
+                throw runtime_error("Invalid binary variable in the clusters.");
+            cluster_per_binary[var_index] = (int)c;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+vector<vector<IloInt>> FeasibilityPump_Decoder::buildSubproblems(
+        const vector<int8_t>& local_fixed) {
+
+    auto &variables = variables_per_thread[0];
+    auto &constraints = constraints_per_thread[0];
+    const IloInt NUM_BINARIES = binary_variables_per_thread[0].getSize();
+
+    // Union-find over all variables, joining the free variables (binaries
+    // and continuous) that share a constraint.
+    vector<IloInt> parent(variables.getSize());
+    iota(parent.begin(), parent.end(), 0);
+
+    auto find = [&parent](IloInt v) {
+        while(parent[v] != v)
+            v = parent[v] = parent[parent[v]];
+        return v;
+    };
+
+    for(IloInt i = 0; i < constraints.getSize(); ++i) {
+        IloInt first = -1;
+        for(auto it = constraints[i].getLinearIterator(); it.ok(); ++it) {
+            auto var = it.getVar();
+
+            if(var.getType() == IloNumVar::Bool) {
+                if(local_fixed[binary_variables_id_index[var.getId()]] != -1)
+                    continue;
+            }
+            else if(var.getUB() - var.getLB() < EPS)
+                continue;
+
+            const auto root = find(variables_id_index[var.getId()]);
+            if(first == -1)
+                first = root;
+            else
+                parent[root] = find(first);
+        }
+    }
+
+    // Now, group the free binaries by cluster or component.
+    const IloInt num_clusters = (mip_local_search_decomposition == DecompositionType::CLUSTERS)?
+            *max_element(cluster_per_binary.begin(), cluster_per_binary.end()) + 1 : 0;
+
+    unordered_map<IloInt, size_t> part_index;
+    vector<vector<IloInt>> parts;
+
+    for(IloInt j = 0; j < NUM_BINARIES; ++j) {
+        if(local_fixed[j] != -1)
+            continue;
+
+        IloInt key;
+        if(num_clusters > 0 && cluster_per_binary[j] > -1)
+            key = cluster_per_binary[j];
+        else
+            key = num_clusters + find(binary_variables_indices[j]);
+
+        auto it = part_index.find(key);
+        if(it == part_index.end()) {
+            part_index[key] = parts.size();
+            parts.emplace_back();
+            parts.back().push_back(j);
+        }
+        else
+            parts[it->second].push_back(j);
+    }
+
+    return parts;
+}
+
+//----------------------------------------------------------------------------//
+
+bool FeasibilityPump_Decoder::performDecomposedMIPLocalSearch(
+        const double max_time, vector<int8_t>& local_fixed,
+        size_t& num_unfixed_vars) {
+
+    const IloInt NUM_BINARIES = binary_variables_per_thread[0].getSize();
+
+    auto parts = buildSubproblems(local_fixed);
+    if(parts.size() < 2)
+        return false;
+
+    // Pack the parts in one sub-MIP per worker thread, the largest parts
+    // first on the least loaded sub-MIP. The sub-MIPs use the threads
+    // 1..num_threads - 1 since thread 0 holds the global sub-MIP.
+    const size_t num_groups = min(parts.size(), size_t(num_threads - 1));
+
+    sort(parts.begin(), parts.end(),
+         [](const vector<IloInt>& a, const vector<IloInt>& b) {
+             return a.size() > b.size();
+         });
+
+    vector<vector<size_t>> groups(num_groups);
+    vector<size_t> group_load(num_groups, 0);
+    vector<size_t> group_of_part(parts.size());
+    for(size_t p = 0; p < parts.size(); ++p) {
+        const size_t g = min_element(group_load.begin(), group_load.end()) -
+                         group_load.begin();
+        groups[g].push_back(p);
+        group_load[g] += parts[p].size();
+        group_of_part[p] = g;
+    }
+
+    // Which part each free binary belongs to.
+    vector<int> part_of_binary(NUM_BINARIES, -1);
+    for(size_t p = 0; p < parts.size(); ++p)
+        for(const auto j : parts[p])
+            part_of_binary[j] = (int)p;
+
+    // The sub-MIP solutions are merged in a separated vector. Each sub-MIP
+    // writes only the variables of its own parts.
+    vector<uint8_t> feasible_group(num_groups, 0);
+    vector<int8_t> merged(local_fixed);
+
+    // The rows of each group. A sub-MIP keeps only the rows with some free
+    // binary of its parts, or with no free binary at all. The free binaries
+    // of the other parts are not fixed, so the feasibility of a part never
+    // depends on the rounding of another part, which may be the very one
+    // violating its rows.
+    const auto &matrix = constraint_matrix;
+    const IloInt NUM_CONSTRAINTS = IloInt(matrix.type.size());
+    vector<vector<IloInt>> dropped_rows(num_groups);
+    vector<int> groups_in_row;
+
+    for(IloInt i = 0; i < NUM_CONSTRAINTS; ++i) {
+        groups_in_row.clear();
+        for(size_t k = matrix.row_begin[i]; k < matrix.row_begin[i + 1]; ++k) {
+            const int p = part_of_binary[matrix.index[k]];
+            if(p != -1)
+                groups_in_row.push_back(int(group_of_part[p]));
+        }
+
+        if(groups_in_row.empty())
+            continue;
+
+        sort(groups_in_row.begin(), groups_in_row.end());
+        groups_in_row.erase(unique(groups_in_row.begin(), groups_in_row.end()),
+                            groups_in_row.end());
+
+        for(size_t g = 0, k = 0; g < num_groups; ++g) {
+            if(k < groups_in_row.size() && groups_in_row[k] == int(g))
+                ++k;
+            else
+                dropped_rows[g].push_back(i);
+        }
+    }
+
+    #ifdef DEBUG
+    cout << "\n** Decomposed MIP local search: " << parts.size()
+         << " parts in " << num_groups << " sub-MIPs" << endl;
+    #endif
+
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(num_groups) schedule(dynamic)
+    #endif
+    for(size_t g = 0; g < num_groups; ++g) {
+        const int t = int(g) + 1;
+        auto &model = model_per_thread[t];
+        auto &constraints = constraints_per_thread[t];
+
+        IloRangeArray dropped(environment_per_thread[t]);
+        for(const auto i : dropped_rows[g])
+            dropped.add(constraints[i]);
+        model.remove(dropped);
+
+        if(solveSubMIP(t, local_fixed, max_time, 1)) {
+            // Each sub-MIP writes only its own variables.
+            const auto &current_values = current_values_per_thread[t];
+            for(const auto p : groups[g])
+                for(const auto j : parts[p])
+                    merged[j] = int8_t(round(current_values[j]));
+
+            feasible_group[g] = 1;
+        }
+
+        model.add(dropped);
+        dropped.end();
+    }
+
+    num_subproblems = num_groups;
+    num_feasible_subproblems = accumulate(feasible_group.begin(),
+                                          feasible_group.end(), 0u);
+
+    #ifdef DEBUG
+    cout << "** Feasible sub-MIPs: " << num_feasible_subproblems
+         << " / " << num_subproblems << endl;
+    #endif
+
+    if(mustStopMIPLocalSearch())
+        return false;
+
+    // Verify the merged solution fixing all binaries in thread 0.
+    auto &cplex = cplex_per_thread[0];
+    auto &binary_variables = binary_variables_per_thread[0];
+
+    vector<IloInt> indices(NUM_BINARIES);
+    vector<UpperLowerBounds> bounds(NUM_BINARIES);
+    for(IloInt j = 0; j < NUM_BINARIES; ++j) {
+        indices[j] = j;
+        bounds[j].lb = binary_variables[j].getLB();
+        bounds[j].ub = binary_variables[j].getUB();
+    }
+
+    if(num_feasible_subproblems == num_subproblems) {
+        setBinaryFixing(merged, 0);
+
+        cplex.solve();
+
+        if(cplex.getStatus() == IloAlgorithm::Feasible ||
+           cplex.getStatus() == IloAlgorithm::Optimal)
+            return true;
+
+        // The parts are coupled by some constraints: let the global
+        // sub-MIP work on all free variables.
+        setBinaryBounds(indices, bounds, 0);
+
+        return false;
+    }
+
+    // Fix the parts already solved and keep the others free for the
+    // global sub-MIP.
+    indices.clear();
+    bounds.clear();
+    for(IloInt j = 0; j < NUM_BINARIES; ++j) {
+        if(local_fixed[j] != -1 || part_of_binary[j] == -1)
+            continue;
+
+        if(feasible_group[group_of_part[part_of_binary[j]]]) {
+            indices.push_back(j);
+            bounds.emplace_back(merged[j], merged[j]);
+            local_fixed[j] = merged[j];
+            --num_unfixed_vars;
+        }
+    }
+
+    setBinaryBounds(indices, bounds, 0);
+
+    return false;
+}
+
+//----------------------------------------------------------------------------//
+
+bool FeasibilityPump_Decoder::solveSubMIP(const int thread,
+        const vector<int8_t>& fixing, const double max_time,
+        const int cplex_threads) {
+
+    auto &env = environment_per_thread[thread];
+    auto &cplex = cplex_per_thread[thread];
+    auto &model = model_per_thread[thread];
+    auto &binary_variables = binary_variables_per_thread[thread];
+
+    setBinaryFixing(fixing, thread);
+
+    model.remove(relaxer_per_thread[thread]);
+    model.remove(fp_objective_per_thread[thread]);
+    model.add(original_objective_per_thread[thread]);
+
+    cplex.setParam(IloCplex::Param::Threads, cplex_threads);
+    cplex.setParam(IloCplex::Param::Emphasis::MIP, CPX_MIPEMPHASIS_FEASIBILITY);
+    cplex.setParam(IloCplex::Param::TimeLimit, max_time);
+
+    int first_source = -1;
+    auto stop_when_find_feasible_callback =
+            StopWhenFindFeasibleCallback(env, this, &first_source);
+    auto stop_ctrl_c_or_time_callback = StopCtrlCorTimeCallback(env, this);
+    cplex.use(stop_when_find_feasible_callback);
+    cplex.use(stop_ctrl_c_or_time_callback);
+
+    const int num_starts = addEliteMIPStarts(thread, fixing);
+
+    cplex.solve();
+
+    bool feasible = false;
+    if(cplex.getStatus() == IloAlgorithm::Feasible ||
+       cplex.getStatus() == IloAlgorithm::Optimal) {
+        cplex.getValues(binary_variables, current_values_per_thread[thread]);
+        feasible = true;
+    }
+
+    accountMIPStarts(thread, fixing, num_starts, first_source, feasible);
+
+    // Restore the thread for the decoding.
+    setBinaryFixing(fixed_vars, thread);
+
+    model.remove(original_objective_per_thread[thread]);
+    model.add(fp_objective_per_thread[thread]);
+    model.add(relaxer_per_thread[thread]);
+
+    cplex.remove(stop_when_find_feasible_callback);
+    cplex.remove(stop_ctrl_c_or_time_callback);
+    cplex.setParam(IloCplex::Param::Emphasis::MIP, CPX_MIPEMPHASIS_BALANCED);
+    cplex.setParam(IloCplex::Param::TimeLimit, 1e+75);
+    cplex.setParam(IloCplex::Param::Threads, 1);
+
+    return feasible;
+}
+
+//----------------------------------------------------------------------------//
+// Portfolio of neighbourhoods
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::setMIPLocalSearchPortfolio(
+        const vector<NeighbourhoodParams>& portfolio) {
+
+    if(portfolio.size() > (size_t)num_threads)
+        throw runtime_error("The portfolio cannot have more neighbourhoods than threads.");
+
+    for(const auto &params : portfolio)
+        if(params.discrepancy_level < 0.0 || params.discrepancy_level > 1.0)
+            throw runtime_error("The discrepancy level must be in the range [0,1].");
+
+    mip_local_search_portfolio = portfolio;
+}
+
+//----------------------------------------------------------------------------//
+
+size_t FeasibilityPump_Decoder::buildNeighbourhood(const Population& population,
+        const unsigned num_chromosomes, const double discrepancy,
+        const unsigned unfix_level, vector<int8_t>& local_fixed) {
+
+    auto &constraints = constraints_per_thread[0];
+    const IloInt NUM_BINARIES = binary_variables_per_thread[0].getSize();
+
+    // Fix the variables with (almost) the same value in the roundings.
+    const vector<int> &histogram = population.getEliteHistogram(num_chromosomes);
+
+    local_fixed.assign(NUM_BINARIES, -1);
+    size_t num_free = NUM_BINARIES;
+
+    for(IloInt j = 0; j < NUM_BINARIES; ++j) {
+        const auto value = histogram[j] / (double) num_chromosomes;
+        if(value < (discrepancy + EPS) || value > (1 - discrepancy - EPS)) {
+            local_fixed[j] = int8_t(round(value));
+            --num_free;
+        }
+    }
+
+    // Unfix the variables that may repair the violated constraints, as in
+    // performMIPLocalSearch().
+    const auto &matrix = constraint_matrix;
+    vector<uint8_t> candidates;
+    findViolatedRows(local_fixed, candidates);
+
+    for(IloInt i = 0; i < constraints.getSize() && !mustStopMIPLocalSearch(); ++i) {
+        size_t hash_value = 0;
+
+        if(!candidates[i] || !isViolatedByFixing(i, local_fixed, hash_value))
+            continue;
+
+        const char constraint_type = matrix.type[i];
+
+        for(size_t k = matrix.row_begin[i]; k < matrix.row_begin[i + 1]; ++k) {
+            const auto var_index = matrix.index[k];
+            const auto coef = matrix.coef[k];
+
+            if(local_fixed[var_index] != -1 &&
+               ((constraint_type == 'e') ||
+                (local_fixed[var_index] == 0 &&
+                 ((constraint_type == 'l' && coef < 0.0) ||
+                  (constraint_type == 'g' && coef > 0.0))))) {
+                local_fixed[var_index] = -1;
+                ++num_free;
+            }
+        }
+    }
+
+    // Now, unfix the neighbours level by level.
+    vector<IloInt> current;
+    vector<IloInt> next;
+    boost::dynamic_bitset<> taken_constraints(constraints.getSize());
+
+    for(IloInt j = 0; j < NUM_BINARIES; ++j)
+        if(local_fixed[j] == -1)
+            current.push_back(j);
+
+    for(unsigned level = 0; level < unfix_level && !current.empty() &&
+                            !mustStopMIPLocalSearch(); ++level) {
+        next.clear();
+        for(const auto var_index : current) {
+            for(size_t p = matrix.column_begin[var_index];
+                p < matrix.column_begin[var_index + 1]; ++p) {
+                const auto row = matrix.rows[p];
+                if(taken_constraints.test(row))
+                    continue;
+
+                taken_constraints.set(row);
+
+                for(size_t k = matrix.row_begin[row]; k < matrix.row_begin[row + 1]; ++k) {
+                    const auto index = matrix.index[k];
+                    if(local_fixed[index] != -1) {
+                        local_fixed[index] = -1;
+                        next.push_back(index);
+                        ++num_free;
+                    }
+                }
+            }
+        }
+        current.swap(next);
+    }
+
+    return num_free;
+}
+
+//----------------------------------------------------------------------------//
+
+bool FeasibilityPump_Decoder::racePortfolio(const Population& population,
+        const unsigned num_chromosomes, const double max_time,
+        Chromosome& possible_feasible, size_t& num_unfixed_vars) {
+
+    const auto &portfolio = mip_local_search_portfolio;
+    const int num_racers = (int)portfolio.size();
+    const IloInt NUM_BINARIES = binary_variables_per_thread[0].getSize();
+
+    // The neighbourhoods are built on thread 0 objects, so sequentially.
+    vector<vector<int8_t>> fixings(num_racers);
+    vector<size_t> num_free(num_racers, 0);
+    for(int r = 0; r < num_racers && !mustStopMIPLocalSearch(); ++r)
+        num_free[r] = buildNeighbourhood(population, num_chromosomes,
+                                         portfolio[r].discrepancy_level,
+                                         portfolio[r].unfix_level, fixings[r]);
+
+    portfolio_winner = -1;
+    num_subproblems = 0;
+    num_feasible_subproblems = 0;
+
+    if(mustStopMIPLocalSearch()) {
+        num_unfixed_vars = num_free[0];
+        return false;
+    }
+
+    #ifdef DEBUG
+    cout << "\n** Racing " << num_racers << " neighbourhoods" << endl;
+    #endif
+
+    portfolio_solved = false;
+    std::atomic<int> winner(-1);
+    const int cplex_threads = max(1, num_threads / num_racers);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(num_racers) schedule(static, 1)
+    #endif
+    for(int r = 0; r < num_racers; ++r) {
+        if(!solveSubMIP(r, fixings[r], max_time, cplex_threads))
+            continue;
+
+        // Only the first one takes the prize and stops the others.
+        int expected = -1;
+        if(winner.compare_exchange_strong(expected, r)) {
+            portfolio_solved = true;
+
+            const auto &current_values = current_values_per_thread[r];
+            for(IloInt j = 0; j < NUM_BINARIES; ++j) {
+                possible_feasible[j] = current_values[j];
+                possible_feasible.rounded[j] = (int) round(current_values[j]);
+            }
+
+            possible_feasible.feasibility_pump_value = 0.0;
+            possible_feasible.fractionality = 0.0;
+            possible_feasible.num_non_integral_vars = 0;
+        }
+    }
+
+    portfolio_solved = false;
+    portfolio_winner = winner;
+
+    num_unfixed_vars = num_free[portfolio_winner > -1? portfolio_winner : 0];
+    feasible_before_var_unfixing = portfolio_winner > -1 &&
+                                   portfolio[portfolio_winner].unfix_level == 0;
+
+    #ifdef DEBUG
+    cout << "** Portfolio winner: " << portfolio_winner << endl;
+    #endif
+
+    return portfolio_winner > -1;
+}
+
+//----------------------------------------------------------------------------//
+// MIP starts from the elite roundings
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::collectEliteRoundings(const Population& population,
+                                                    const unsigned num_chromosomes) {
+    elite_roundings.clear();
+
+    const unsigned num_elite = min({num_mip_starts, num_chromosomes,
+                                    population.getP()});
+    const IloInt NUM_BINARIES = binary_variables_per_thread[0].getSize();
+
+    // The population is sorted by fitness, so the best roundings come first.
+    for(unsigned i = 0; i < num_elite; ++i) {
+        const auto &chr = population.getChromosome(i);
+        vector<int8_t> rounding(NUM_BINARIES);
+        for(IloInt j = 0; j < NUM_BINARIES; ++j)
+            rounding[j] = int8_t(chr.rounded[j]);
+
+        if(find(elite_roundings.begin(), elite_roundings.end(), rounding) ==
+           elite_roundings.end())
+            elite_roundings.push_back(move(rounding));
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+int FeasibilityPump_Decoder::addEliteMIPStarts(const int thread,
+                                               const vector<int8_t>& fixing) {
+    if(elite_roundings.empty())
+        return 0;
+
+    auto &env = environment_per_thread[thread];
+    auto &cplex = cplex_per_thread[thread];
+    auto &binary_variables = binary_variables_per_thread[thread];
+    const IloInt NUM_BINARIES = binary_variables.getSize();
+
+    IloNumVarArray free_vars(env);
+    for(IloInt j = 0; j < NUM_BINARIES; ++j)
+        if(fixing[j] == -1)
+            free_vars.add(binary_variables[j]);
+
+    // Nothing to start from. The fixed variables are up to CPLEX.
+    if(free_vars.getSize() == 0) {
+        free_vars.end();
+        return 0;
+    }
+
+    // The fixed variables are not given, since the rounding may disagree
+    // with the fixing. CPLEX completes the partial start or repairs it.
+    int num_starts = 0;
+    for(const auto &rounding : elite_roundings) {
+        IloNumArray values(env);
+        for(IloInt j = 0; j < NUM_BINARIES; ++j)
+            if(fixing[j] == -1)
+                values.add(rounding[j]);
+
+        cplex.addMIPStart(free_vars, values, IloCplex::MIPStartRepair);
+        values.end();
+        ++num_starts;
+    }
+
+    free_vars.end();
+    return num_starts;
+}
+
+//----------------------------------------------------------------------------//
+
+void FeasibilityPump_Decoder::accountMIPStarts(const int thread,
+        const vector<int8_t>& fixing, const int num_starts,
+        const int first_source, const bool feasible) {
+
+    if(num_starts == 0)
+        return;
+
+    auto &cplex = cplex_per_thread[thread];
+    ++num_started_subproblems;
+
+    if(feasible &&
+       first_source == int(IloCplex::IncumbentCallbackI::MIPStartSolution)) {
+        auto &binary_variables = binary_variables_per_thread[thread];
+        auto &current_values = current_values_per_thread[thread];
+        const IloInt NUM_BINARIES = binary_variables.getSize();
+
+        cplex.getValues(binary_variables, current_values);
+
+        // If the solution matches some start on the free variables, the
+        // start was taken as given. Otherwise, CPLEX repaired it.
+        bool as_given = false;
+        for(const auto &rounding : elite_roundings) {
+            IloInt j = 0;
+            for(; j < NUM_BINARIES; ++j)
+                if(fixing[j] == -1 &&
+                   int8_t(round(current_values[j])) != rounding[j])
+                    break;
+
+            if(j == NUM_BINARIES) {
+                as_given = true;
+                break;
+            }
+        }
+
+        if(as_given)
+            ++num_mip_starts_accepted;
+        else
+            ++num_mip_starts_repaired;
+    }
+
+    cplex.deleteMIPStarts(0, cplex.getNMIPStarts());
+}
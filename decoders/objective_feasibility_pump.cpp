@@ -11,7 +11,7 @@
  *     All Rights Reserved.
  *
  *  Created on : Mar 19, 2015 by andrade
- *  Last update: Jun 25, 2015 by andrade
+ *  Last update: Oct 18, 2026 by andrade
  *
  * This code is released under LICENSE.md.
  *
@@ -41,6 +41,7 @@
 #include <functional>
 #include <numeric>
 #include <cmath>
+#include <chrono>
 #include <omp.h>
 
 #include "pragma_diagnostic_ignored_header.hpp"
@@ -52,6 +53,51 @@ ILOSTLBEGIN
 
 //----------------------------------------------------------------------------//
 
+// Interrupt a projection LP on user interruption, time, or when the decoding
+// runs out of budget. CPLEX calls it at every simplex/barrier iteration.
+ILOCONTINUOUSCALLBACK1(StopProjectionCallback,
+                       const chrono::steady_clock::time_point*, deadline) {
+    if(ExecutionStopper::mustStop() || chrono::steady_clock::now() > *deadline)
+        abort();
+}
+
+// Attach StopProjectionCallback and the work limit to a projection LP, and
+// detach them when the pump returns or throws. The same CPLEX object solves
+// MIPs during the fixing and local search, so they must not stay behind.
+class ProjectionLimits {
+public:
+    ProjectionLimits(IloCplex &_cplex,
+                     const chrono::steady_clock::time_point* deadline,
+                     const double _work_limit):
+        cplex(_cplex),
+        callback(cplex.use(StopProjectionCallback(cplex.getEnv(), deadline))),
+        work_limit(_work_limit)
+    {
+        if(work_limit > 0.0)
+            cplex.setParam(IloCplex::Param::DetTimeLimit, work_limit);
+    }
+
+    ~ProjectionLimits() {
+        try {
+            cplex.remove(callback);
+            callback.end();
+            if(work_limit > 0.0)
+                cplex.setParam(IloCplex::Param::DetTimeLimit, 1e+75);
+        }
+        catch(IloException&) {}
+    }
+
+private:
+    ProjectionLimits(const ProjectionLimits&) = delete;
+    ProjectionLimits& operator=(const ProjectionLimits&) = delete;
+
+    IloCplex &cplex;
+    IloCplex::Callback callback;
+    const double work_limit;
+};
+
+//----------------------------------------------------------------------------//
+
 double FeasibilityPump_Decoder::objectiveFeasibilityPump(Chromosome& chromosome,
                                                          const double phi,
                                                          const double delta) {
@@ -79,6 +125,8 @@ double FeasibilityPump_Decoder::objectiveFeasibilityPump(Chromosome& chromosome,
     MTRand &rng = rng_per_thread[omp_get_thread_num()];
     vector<std::pair<double, IloInt>> &sorted = sorted_per_thread[omp_get_thread_num()];
     unsigned &solved_lps = solved_lps_per_thread[omp_get_thread_num()];
+    ReducedModel &reduced = reduced_model_per_thread[omp_get_thread_num()];
+    const int thread = omp_get_thread_num();
     #else
     IloEnv &env = environment_per_thread[0];
     IloObjective &objective = fp_objective_per_thread[0];
@@ -94,8 +142,23 @@ double FeasibilityPump_Decoder::objectiveFeasibilityPump(Chromosome& chromosome,
     MTRand &rng = rng_per_thread[0];
     vector<std::pair<double, IloInt>> &sorted = sorted_per_thread[0];
     unsigned &solved_lps = solved_lps_per_thread[0];
+    ReducedModel &reduced = reduced_model_per_thread[0];
+    const int thread = 0;
     #endif
 
+    // After a fixing, the projections are done on the reduced models,
+    // which have only the free binaries (see buildReducedModels()).
+    // The roundings and values below keep the full layout.
+    const bool use_reduced = reduced_models_active;
+    IloCplex &lp_cplex = use_reduced? reduced.cplex : cplex;
+    IloObjective &lp_objective = use_reduced? reduced.objective : objective;
+
+    // The projections are interrupted by the stopper, the decoding budget,
+    // or the work limit. Then, the pump stops with the best rounding so far.
+    const auto &deadline = decode_deadline_per_thread[thread];
+    ProjectionLimits projection_limits(lp_cplex, &deadline, lp_work_limit);
+    bool interrupted = false;
+
     // Take the last key and use it as the seed for random number generator.
     const MTRand::uint32 local_seed = (MTRand::uint32)(chromosome.back() *
                                                        numeric_limits<MTRand::uint32>::max());
@@ -271,49 +334,102 @@ double FeasibilityPump_Decoder::objectiveFeasibilityPump(Chromosome& chromosome,
         IloExpr obj_expr(env);
         IloExpr tmp_expr(env);
 
-        for(IloInt i = 0; i < NUM_BINARIES; ++i) {
-            if(rounded_values[i] + EPS > binary_variables[i].getUB()) {
-                tmp_expr -= binary_variables[i];
-                fp_constant += binary_variables[i].getUB();
+        if(use_reduced) {
+            // Free binaries have their original bounds.
+            for(size_t k = 0; k < reduced_to_full.size(); ++k) {
+                const IloInt i = reduced_to_full[k];
+                if(rounded_values[i] + EPS > binary_variables_bounds[i].ub) {
+                    tmp_expr -= reduced.binaries[k];
+                    fp_constant += binary_variables_bounds[i].ub;
+                }
+                else if(rounded_values[i] - EPS < binary_variables_bounds[i].lb) {
+                    tmp_expr += reduced.binaries[k];
+                    fp_constant += binary_variables_bounds[i].lb;
+                }
             }
-            else if(rounded_values[i] - EPS < binary_variables[i].getLB()) {
-                tmp_expr += binary_variables[i];
-                fp_constant += binary_variables[i].getLB();
+        }
+        else {
+            for(IloInt i = 0; i < NUM_BINARIES; ++i) {
+                if(rounded_values[i] + EPS > binary_variables[i].getUB()) {
+                    tmp_expr -= binary_variables[i];
+                    fp_constant += binary_variables[i].getUB();
+                }
+                else if(rounded_values[i] - EPS < binary_variables[i].getLB()) {
+                    tmp_expr += binary_variables[i];
+                    fp_constant += binary_variables[i].getLB();
+                }
+//                else {
+//                    // From the original FP source code.
+//                    throw runtime_error("Hey, we have a binary var that, once rounded, is not at a bound. This shouldn't happen!");
+//                }
             }
-//            else {
-//                // From the original FP source code.
-//                throw runtime_error("Hey, we have a binary var that, once rounded, is not at a bound. This shouldn't happen!");
-//            }
         }
 
         fp_constant *= 1 - alpha;
 
         // Add the original obj function pondered by alpha
-        auto orig_expr = original_objective.getExpr();
+        IloNumExprArg orig_expr = use_reduced? IloNumExprArg(reduced.original_expr) :
+                                               original_objective.getExpr();
         obj_expr += (1 - alpha) * tmp_expr  +
                     (alpha * local_norm / c_norm) *
                     ((original_objective.getSense() == IloObjective::Sense::Maximize)?
                      -orig_expr : orig_expr);
 
         obj_expr.normalize();
-        objective.setExpr(obj_expr);
-        objective.setSense(IloObjective::Sense::Minimize);
+        lp_objective.setExpr(obj_expr);
+        lp_objective.setSense(IloObjective::Sense::Minimize);
         obj_expr.end();
         tmp_expr.end();
 
-        ++solved_lps;
-        if(!cplex.solve()) {
-             stringstream message;
-             message << "Failed to optimize LP. Status: " << cplex.getStatus();
-             throw IloCplex::Exception(cplex.getStatus(), message.str().c_str());
+        // Solve the projection. If the solution violates some cuts of the
+        // rounding cut pool, attach them and solve again. The attached cuts
+        // are aged only on the first solve, so they only grow afterwards.
+        for(bool age_cuts = true; ; age_cuts = false) {
+            ++solved_lps;
+            const bool solved = lp_cplex.solve();
+
+            if(lp_cplex.getCplexStatus() == IloCplex::AbortUser ||
+               lp_cplex.getCplexStatus() == IloCplex::AbortDetTimeLim) {
+                interrupted = true;
+                break;
+            }
+
+            if(!solved) {
+                 stringstream message;
+                 message << "Failed to optimize LP. Status: " << lp_cplex.getStatus();
+                 throw IloCplex::Exception(lp_cplex.getStatus(), message.str().c_str());
+            }
+
+            if(use_reduced) {
+                lp_cplex.getValues(reduced.binaries, reduced.values);
+                for(size_t k = 0; k < reduced_to_full.size(); ++k)
+                    current_values[reduced_to_full[k]] = reduced.values[k];
+
+                // The fixed variables keep their values along the pump.
+                if(iteration == 1)
+                    for(IloInt i = 0; i < NUM_BINARIES; ++i)
+                        if(fixed_vars[i] != -1)
+                            current_values[i] = fixed_vars[i];
+            }
+            else {
+                cplex.getValues(binary_variables, current_values);
+            }
+
+            if(!separateRoundingCuts(thread, current_values, age_cuts))
+                break;
+        }
+
+        if(interrupted) {
+            #ifdef DEBUG
+            cout << "\n\n** Projection interrupted. Stopping..." << endl;
+            #endif
+            break;
         }
 
         double dist = 0.0;
         unsigned violations = 0;
         double fractionality = 0.0;
 
-        cplex.getValues(binary_variables, current_values);
-
         //  Compute the distance, violations, and fractionality.
         for(IloInt i = 0; i < NUM_BINARIES; ++i) {
             #ifdef FULLDEBUG
@@ -328,8 +444,8 @@ double FeasibilityPump_Decoder::objectiveFeasibilityPump(Chromosome& chromosome,
         }
 
         #ifdef DEBUG
-        cout << "\n> Full obj: " << (cplex.getObjValue() + fp_constant)
-             << "\n> Origin. obj: " << cplex.getValue(original_objective.getExpr())
+        cout << "\n> Full obj: " << (lp_cplex.getObjValue() + fp_constant)
+             << "\n> Origin. obj: " << lp_cplex.getValue(orig_expr)
              << "\n> Distance (frac/int): " << dist
              << "\n> Fractionality: " << fractionality
              << "\n> Violations: " << violations
@@ -389,6 +505,23 @@ double FeasibilityPump_Decoder::objectiveFeasibilityPump(Chromosome& chromosome,
         if(iter_without_improvement == fp_params.iteration_limit ||
            ExecutionStopper::mustStop())
             break;
+
+        // Also if the decoding runs out of budget.
+        if(chrono::steady_clock::now() > deadline) {
+            interrupted = true;
+            break;
+        }
+    }
+
+    if(interrupted) {
+        if(!ExecutionStopper::mustStop())
+            ++cut_short_decodes_per_thread[thread];
+
+        // Interrupted on the first projection: we have only the rounding
+        // of the chromosome itself.
+        if(best_value >= numeric_limits<double>::max() - EPS)
+            for(IloInt i = 0; i < NUM_BINARIES; ++i)
+                best_rounding.rounded[i] = (int) rounded_values[i];
     }
 
     chromosome.feasibility_pump_value = best_value;
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * speculative_var_fixing.cpp: Implementation for SpeculativeVarFixing class.
+ *
+ * Author: Carlos Eduardo de Andrade
+ *         <carlos.andrade@gatech.edu / ce.andrade@gmail.com>
+ *
+ * (c) Copyright 2015-2019
+ *     Industrial and Systems Engineering, Georgia Institute of Technology
+ *     All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by andrade
+ *  Last update: Oct 18, 2026 by andrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+
+#include "speculative_var_fixing.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+//-------------------------[ Default Constructor ]----------------------------//
+
+SpeculativeVarFixing::SpeculativeVarFixing(FeasibilityPump_Decoder& _probe_decoder,
+                                           FeasibilityPump_Decoder& _decoder):
+        probe_decoder(_probe_decoder),
+        decoder(_decoder),
+        worker(),
+        finished(false),
+        snapshot(),
+        solution(),
+        worked(false),
+        num_fixings(0),
+        fixing_percentage(0.0),
+        error(),
+        last_time()
+{}
+
+//-----------------------------[ Destructor ]---------------------------------//
+
+SpeculativeVarFixing::~SpeculativeVarFixing() {
+    cancel();
+}
+
+//-------------------------------[ Launch ]-----------------------------------//
+
+bool SpeculativeVarFixing::launch(const Population& population,
+                                  const unsigned num_chromosomes,
+                                  const FeasibilityPump_Decoder::FixingType fixing,
+                                  const double _fixing_percentage) {
+    if(worker.joinable())
+        return false;
+
+    snapshot.reset(new Population(population));
+    solution = population.getChromosome(0);
+    worked = false;
+    num_fixings = 0;
+    fixing_percentage = _fixing_percentage;
+    error = nullptr;
+    finished = false;
+
+    probe_decoder.variable_fixing_percentage = fixing_percentage;
+    probe_decoder.clearMIPLocalSearchAbort();
+
+    worker = thread([this, num_chromosomes, fixing]() {
+        boost::timer::cpu_timer timer;
+        try {
+            worked = probe_decoder.analyzeAndFixVars(*snapshot, num_chromosomes,
+                                                     fixing, solution,
+                                                     num_fixings);
+        }
+        catch(...) {
+            error = current_exception();
+            worked = false;
+        }
+        last_time = timer.elapsed();
+        finished = true;
+    });
+
+    return true;
+}
+
+//-------------------------------[ Collect ]----------------------------------//
+
+bool SpeculativeVarFixing::collect(Chromosome& possible_feasible,
+                                   unsigned& _num_fixings) {
+    if(!worker.joinable())
+        return false;
+
+    worker.join();
+    finished = false;
+
+    if(error) {
+        auto tmp = error;
+        error = nullptr;
+        rethrow_exception(tmp);
+    }
+
+    _num_fixings = num_fixings;
+    if(!worked)
+        return false;
+
+    // Either the probing found a feasible solution...
+    if(solution.num_non_integral_vars == 0) {
+        copy(solution.begin(), solution.end(), possible_feasible.begin());
+        copy(solution.rounded.begin(), solution.rounded.end(),
+             possible_feasible.rounded.begin());
+        possible_feasible.feasibility_pump_value = solution.feasibility_pump_value;
+        possible_feasible.fractionality = solution.fractionality;
+        possible_feasible.num_non_integral_vars = solution.num_non_integral_vars;
+    }
+    // ...or we commit its fixing.
+    else {
+        decoder.applyFixing(probe_decoder.getFixedVars());
+    }
+
+    return true;
+}
+
+//-------------------------------[ Cancel ]-----------------------------------//
+
+void SpeculativeVarFixing::cancel() {
+    if(!worker.joinable())
+        return;
+
+    probe_decoder.abortMIPLocalSearch();
+    worker.join();
+    finished = false;
+    error = nullptr;
+    worked = false;
+}
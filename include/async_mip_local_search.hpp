@@ -0,0 +1,171 @@
+/******************************************************************************
+ * async_mip_local_search.hpp: Interface for AsyncMIPLocalSearch class.
+ *
+ * Author: Carlos Eduardo de Andrade
+ *         <carlos.andrade@gatech.edu / ce.andrade@gmail.com>
+ *
+ * (c) Copyright 2015-2019
+ *     Industrial and Systems Engineering, Georgia Institute of Technology
+ *     All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by andrade
+ *  Last update: Oct 18, 2026 by andrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef ASYNC_MIP_LOCAL_SEARCH_HPP_
+#define ASYNC_MIP_LOCAL_SEARCH_HPP_
+
+#include "feasibility_pump_decoder.hpp"
+#include "population.hpp"
+#include "chromosome.hpp"
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include <boost/timer/timer.hpp>
+
+/**
+ * \brief Runs the MIP local search in background.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * FeasibilityPump_Decoder::performMIPLocalSearch() blocks the caller for
+ * the whole local search. This class runs it in a separated thread, on a
+ * snapshot of the population, so that the BRKGA can keep evolving
+ * meanwhile. The local search uses its own decoder (and so, its own CPLEX
+ * environments), whose number of threads is the thread share of the
+ * local search. Therefore, the decoder used by the BRKGA must be built
+ * with the remaining threads.
+ *
+ * The caller polls hasFinished() (or gives a completion callback) and
+ * collects the result with collect(). If the BRKGA finds a feasible
+ * solution first, cancel() stops the local search.
+ */
+class AsyncMIPLocalSearch {
+    public:
+        /** \name Constructor and Destructor */
+        //@{
+        /** \brief Default Constructor.
+         * \param decoder a decoder used only by the local search. It must be
+         *        initialized (FeasibilityPump_Decoder::init()), and its
+         *        number of threads is the thread share of the local search.
+         * \param on_finish called from the local search thread when it
+         *        finishes, with true if a feasible solution was found.
+         *        It must be thread safe. May be empty.
+         */
+        explicit AsyncMIPLocalSearch(FeasibilityPump_Decoder& decoder,
+                       std::function<void(bool)> on_finish = std::function<void(bool)>());
+
+        /// Destructor. Cancels and waits a running local search.
+        ~AsyncMIPLocalSearch();
+        //@}
+
+        /** \name Main methods */
+        //@{
+        /** \brief Launch the local search on a copy of the population.
+         * Parameters as in FeasibilityPump_Decoder::performMIPLocalSearch().
+         * \param population the chromosomes (copied).
+         * \param num_chromosomes the number of chromosomes to be considered.
+         * \param unfix_level controls the recursion on unfix variables.
+         * \param max_time in seconds, to perform the local search.
+         * \return false if a local search is already running or
+         *         was not collected yet.
+         */
+        bool launch(const Population& population,
+                    const unsigned num_chromosomes,
+                    const unsigned unfix_level,
+                    const double max_time);
+
+        /** \brief Wait for the local search and get its results.
+         * \param[out] possible_feasible the feasible solution, if found.
+         * \param[out] num_unfixed_vars number of variables not fixed.
+         * \return true if a feasible solution was found.
+         * \throw the exception thrown by the local search, if any.
+         */
+        bool collect(Chromosome& possible_feasible, size_t& num_unfixed_vars);
+
+        /// Ask the local search to stop and wait for it. The results are
+        /// discarded.
+        void cancel();
+        //@}
+
+        /** \name Informational methods */
+        //@{
+        /// Indicates if a local search was launched and not collected yet.
+        inline bool isActive() const {
+            return worker.joinable();
+        }
+
+        /// Indicates if the local search finished and can be collected
+        /// without waiting. Reset by collect() and cancel().
+        inline bool hasFinished() const {
+            return finished;
+        }
+
+        /// Time spent by the last collected local search.
+        inline const boost::timer::cpu_times& getLastTime() const {
+            return last_time;
+        }
+        //@}
+
+    private:
+        /** \name Disabled methods */
+        //@{
+        AsyncMIPLocalSearch(const AsyncMIPLocalSearch&) = delete;
+        AsyncMIPLocalSearch& operator=(const AsyncMIPLocalSearch&) = delete;
+        //@}
+
+    protected:
+        /** \name Data members */
+        //@{
+        /// The decoder used only by the local search.
+        FeasibilityPump_Decoder& decoder;
+
+        /// Called when the local search finishes.
+        std::function<void(bool)> on_finish;
+
+        /// The thread running the local search.
+        std::thread worker;
+
+        /// Indicates that the local search finished.
+        std::atomic<bool> finished;
+
+        /// Copy of the population taken on launch().
+        std::unique_ptr<Population> snapshot;
+
+        /// The solution found by the local search.
+        Chromosome solution;
+
+        /// Indicates if the local search found a feasible solution.
+        bool found;
+
+        /// Number of variables not fixed in the local search.
+        size_t num_unfixed_vars;
+
+        /// Exception thrown by the local search, if any.
+        std::exception_ptr error;
+
+        /// Time spent by the last local search.
+        boost::timer::cpu_times last_time;
+        //@}
+};
+
+#endif //ASYNC_MIP_LOCAL_SEARCH_HPP_
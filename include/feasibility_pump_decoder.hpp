@@ -9,7 +9,7 @@
  *     All Rights Reserved.
  *
  *  Created on : Feb 18, 2015 by andrade
- *  Last update: Ago 21, 2015 by andrade
+ *  Last update: Oct 18, 2026 by andrade
  *
  * This code is released under LICENSE.md.
  *
@@ -33,15 +33,19 @@
 #include "brkga_decoder.hpp"
 #include "mtrand.hpp"
 #include "population.hpp"
+#include "execution_stopper.hpp"
 
 #include <vector>
 #include <unordered_map>
+#include <atomic>
+#include <chrono>
 
 // FeasibilityPump has a lot of problems with these flags.
 #include "pragma_diagnostic_ignored_header.hpp"
 #include <cstring>
 #include <ilcplex/ilocplex.h>
 #include "fp_interface.h"
+#include "cutpool.h"
 #include <boost/timer/timer.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include "pragma_diagnostic_ignored_footer.hpp"
@@ -137,6 +141,24 @@ class FeasibilityPump_Decoder: public BRKGA_Decoder {
             /// no-decreasing absolute slack values.
             NONZERO_DUALS_NONZERO_SLACKS
         };
+
+        /// Defines how the neighbourhood of the MIP local search
+        /// (FeasibilityPump_Decoder::performMIPLocalSearch()) is split
+        /// before the global sub-MIP.
+        enum class DecompositionType {
+            /// No decomposition, solve only one sub-MIP with all free variables.
+            NONE,
+            /// Split the free variables in the connected components of the
+            /// constraint graph restricted to free (binary and continuous)
+            /// variables. These sub-MIPs are independent.
+            COMPONENTS,
+            /// Split the free variables using the given variable clusters
+            /// (see FeasibilityPump_Decoder::setMIPLocalSearchDecomposition()).
+            /// Free variables out of any cluster are split by components.
+            /// These sub-MIPs may share constraints, so the merged solution
+            /// may violate some of them.
+            CLUSTERS
+        };
         //@}
 
         /** \name Parameter sets */
@@ -179,6 +201,18 @@ class FeasibilityPump_Decoder: public BRKGA_Decoder {
             /// This parameter is used to detect cycling.
             double delta;
         };
+
+        /// A neighbourhood of the MIP local search, used in the portfolio
+        /// (FeasibilityPump_Decoder::setMIPLocalSearchPortfolio()).
+        struct NeighbourhoodParams {
+            /// The discrepancy level used to fix the variables.
+            /// See FeasibilityPump_Decoder::discrepancy_level.
+            double discrepancy_level;
+
+            /// The recursion level on unfix variables.
+            /// See FeasibilityPump_Decoder::performMIPLocalSearch().
+            unsigned unfix_level;
+        };
         //@}
 
     public:
@@ -278,6 +312,45 @@ class FeasibilityPump_Decoder: public BRKGA_Decoder {
         /// LP initial relaxation.
         virtual double getZerosPercentageInInitialRelaxation() const;
 
+        /// Indicates if the projection LPs are reduced by the current fixing.
+        inline bool isReducedModelActive() const {
+            return reduced_models_active;
+        }
+
+        /// Return the number of binary variables of the reduced models.
+        inline size_t getNumReducedBinaries() const {
+            return reduced_to_full.size();
+        }
+
+        /// Return the number of rows of the reduced models (without cuts).
+        inline size_t getNumReducedRows() const {
+            return num_reduced_rows;
+        }
+
+        /// Return the current fixing: 0, 1, or -1 (free) for each binary.
+        inline const vector<int8_t>& getFixedVars() const {
+            return fixed_vars;
+        }
+
+        /// Return the number of cuts in the rounding cut pool.
+        inline unsigned getRoundingCutPoolSize() const {
+            return rounding_cut_pool.size();
+        }
+
+        /// Return the memory used by the rounding cut pool, in bytes.
+        inline double getRoundingCutPoolMemory() const {
+            return rounding_cut_pool.memoryUsed();
+        }
+
+        /// Return the number of cuts added to the rounding cut pool so far.
+        inline unsigned getNumRoundingCutsAdded() const {
+            return rounding_cut_pool.numAdded();
+        }
+
+        /// Return the number of rows (including the attached cuts) of the
+        /// projection LP of a thread.
+        size_t getNumProjectionRows(const int thread) const;
+
         /** \name Public Support methods. */
         //@{
         /** \brief Initialize the data structures and perform the
@@ -317,8 +390,24 @@ class FeasibilityPump_Decoder: public BRKGA_Decoder {
                                Chromosome& possible_feasible,
                                unsigned& num_fixings);
 
-        /** \brief Insert cuts in the LPs prohibiting the infeasible roundings
-         *         from previous iterations.
+        /** \brief Replace the current variable fixing by the given one, in
+         * all threads, without any probing. It is used to commit a fixing
+         * probed by analyzeAndFixVars() of other decoder of the same
+         * instance (see SpeculativeVarFixing).
+         * \param fixing the value of each binary: 0, 1, or -1 (free).
+         * \throw std::runtime_error if the fixing has the wrong size.
+         */
+        void applyFixing(const vector<int8_t>& fixing);
+
+        /** \brief Insert cuts prohibiting the infeasible roundings
+         *         from previous iterations into the rounding cut pool.
+         *
+         * The cuts are not added to the LPs here. Each thread attaches a
+         * cut to its projection LP only when the cut is violated by the
+         * current LP solution, and removes it when slack for some
+         * projections (see setRoundingCutLimits()). This method also ages
+         * the cuts of the pool and purges it when its limits are reached.
+         *
          * \param population the roundings from the chromosomes
          * \param num_cuts how many cuts to insert. This number must be
          * less or equal to the size of the population. The order of the
@@ -356,6 +445,173 @@ class FeasibilityPump_Decoder: public BRKGA_Decoder {
                                    const double max_time,
                                    Chromosome& possible_feasible,
                                    size_t& num_unfixed_vars);
+
+        /** \brief Set the decomposition of the MIP local search.
+         *
+         * When the decomposition is active, performMIPLocalSearch() splits
+         * the free variables in parts, and solves them concurrently as
+         * independent sub-MIPs on the CPLEX environments of threads
+         * 1..num_threads - 1 (each sub-MIP keeps only the rows of its parts,
+         * and leaves the free variables of the other parts free). The
+         * solutions are merged and verified on thread 0. If the merged
+         * solution is infeasible, the parts solved are fixed and a global
+         * sub-MIP is solved on the remaining parts (or all free variables,
+         * if all parts were solved).
+         * Note that the decomposition needs at least two threads.
+         *
+         * \param type the decomposition type.
+         * \param clusters the clusters of binary variables (indices in
+         *        binary_variables_per_thread), used only with
+         *        DecompositionType::CLUSTERS.
+         * \throw std::runtime_error if the clusters are missing or have
+         *        invalid indices.
+         */
+        void setMIPLocalSearchDecomposition(const DecompositionType type,
+                        const vector<vector<size_t>>& clusters = vector<vector<size_t>>());
+
+        /** \brief Ask a running performMIPLocalSearch() to stop as soon as
+         * possible (for instance, from another thread that found a feasible
+         * solution). The CPLEX probing of analyzeAndFixVars() stops too.
+         * The request holds until clearMIPLocalSearchAbort().
+         */
+        inline void abortMIPLocalSearch() {
+            mip_local_search_abort = true;
+        }
+
+        /// Clear the stop request of abortMIPLocalSearch().
+        inline void clearMIPLocalSearchAbort() {
+            mip_local_search_abort = false;
+        }
+
+        /// Indicates if the MIP local search must stop, either by time,
+        /// user interruption, abortMIPLocalSearch(), or because other
+        /// neighbourhood of the portfolio found a feasible solution.
+        inline bool mustStopMIPLocalSearch() const {
+            return ExecutionStopper::mustStop() || mip_local_search_abort ||
+                   portfolio_solved;
+        }
+
+        /** \brief Set a portfolio of neighbourhoods for the MIP local search.
+         *
+         * When the portfolio is not empty, performMIPLocalSearch() races
+         * the neighbourhoods, instead of using discrepancy_level and its
+         * unfix_level parameter. Neighbourhood i is built on thread 0 and
+         * solved on the CPLEX environment of thread i, with
+         * num_threads / size of portfolio threads. As soon as one finds a
+         * feasible solution, the others are stopped. The neighbourhoods are
+         * built with all unfix levels at once, without waiting for the
+         * infeasibility of the smaller ones. The portfolio takes precedence
+         * over the decomposition (setMIPLocalSearchDecomposition()).
+         *
+         * \param portfolio the neighbourhoods. Empty disables the portfolio.
+         * \throw std::runtime_error if there are more neighbourhoods than
+         *        threads or invalid discrepancy levels.
+         */
+        void setMIPLocalSearchPortfolio(const vector<NeighbourhoodParams>& portfolio);
+
+        /** \brief Set how many elite roundings are given to CPLEX as MIP starts.
+         *
+         * The roundings of the best num_starts chromosomes (without
+         * duplicates) are added as MIP starts to the sub-MIPs of
+         * performMIPLocalSearch() and to the CPLEX probing of
+         * analyzeAndFixVars(). The starts are partial: only the free
+         * binaries are given, and CPLEX is asked to repair them when
+         * they are infeasible.
+         *
+         * \param num_starts number of starts. Zero disables the MIP starts.
+         */
+        inline void setNumMIPStarts(const unsigned num_starts) {
+            num_mip_starts = num_starts;
+        }
+
+        /** \brief Set if the projection LPs are reduced after fixing.
+         *
+         * When enabled, each successful analyzeAndFixVars() rebuilds the
+         * projection LP of each thread without the fixed binaries and the
+         * rows they make redundant (the fixed values are moved to the row
+         * bounds), and presolves it again. The feasibility pump solves
+         * these smaller LPs, but the chromosomes and roundings keep the
+         * full layout. The reduced models are dropped when the fixing is
+         * undone. The MIP local search uses always the full models.
+         *
+         * \param enable true to reduce the models.
+         */
+        inline void setReducedModels(const bool enable) {
+            reduced_models = enable;
+        }
+
+        /** \brief Set the limits of the rounding cuts.
+         *
+         * When the pool reaches its limits, it is purged by
+         * dominiqs::CutPool::purge() (the older and less violated cuts go
+         * first) until it fits again.
+         *
+         * \param max_pool_cuts maximum number of cuts in the pool.
+         * \param max_pool_memory maximum memory of the pool, in bytes.
+         * \param max_attached maximum number of cuts attached to each
+         *        projection LP.
+         * \param max_slack_age number of consecutive projections in which
+         *        an attached cut may be slack before being removed.
+         */
+        void setRoundingCutLimits(const unsigned max_pool_cuts,
+                                  const double max_pool_memory,
+                                  const unsigned max_attached,
+                                  const unsigned max_slack_age);
+
+        /** \brief Set the deterministic work limit of each projection LP.
+         *
+         * A projection LP that reaches the limit is interrupted, and the
+         * feasibility pump stops with the best rounding found so far.
+         * Note that the projection LPs are also interrupted, within
+         * milliseconds, when ExecutionStopper::mustStop().
+         *
+         * \param ticks the limit in CPLEX deterministic ticks
+         *        (IloCplex::Param::DetTimeLimit). Zero means no limit.
+         * \throw std::runtime_error if the limit is negative.
+         */
+        void setLPWorkLimit(const double ticks);
+
+        /** \brief Set the time budget of each decoding.
+         *
+         * A decoding that takes more than factor times the median time of
+         * the last DECODE_TIME_WINDOW decodings (of the same thread) is cut
+         * short, even in the middle of a projection LP, and the chromosome
+         * gets the best fitness found so far.
+         *
+         * \param factor the budget factor. Zero means no budget.
+         * \throw std::runtime_error if the factor is in (0, 1).
+         */
+        void setDecodeTimeBudget(const double factor);
+
+        /** \brief Set the threads of the component-parallel rounding.
+         *
+         * When the propagation rounding finds independent blocks of
+         * variables, each block is rounded by its own rounder, and the
+         * blocks of one decoding are rounded by _num_threads threads
+         * (nested inside the parallel decoding). The threads are capped
+         * so that the decoding threads times the rounding threads do not
+         * exceed the processors. Must be called before init().
+         *
+         * \param _num_threads rounding threads per decoding thread. Zero or
+         *        one keeps the sequential rounding.
+         * \throw std::runtime_error if the decoder is already initialized.
+         */
+        void setComponentRoundingThreads(const unsigned _num_threads);
+
+        /** \brief Set the probing of the propagation rounding.
+         *
+         * When enabled, the rounders probe each binary variable once, at
+         * init(), and cache the implications, so the rounding fixes them
+         * in bulk instead of propagating them again. With the
+         * component-parallel rounding, the time limit is split among the
+         * blocks. Must be called before init().
+         *
+         * \param time_limit wall clock time limit of the probing, in
+         *        seconds. Zero disables the probing.
+         * \throw std::runtime_error if the decoder is already initialized
+         *        or the time limit is negative.
+         */
+        void setRoundingProbing(const double time_limit);
         //@}
 
     private:
@@ -389,6 +645,84 @@ class FeasibilityPump_Decoder: public BRKGA_Decoder {
                 UpperLowerBounds(IloNum _lb, IloNum _ub):
                     lb(_lb), ub(_ub) {}
         };
+
+        /// Copy of the constraints (from thread 0) restricted to the binary
+        /// variables, in compressed sparse row format, used to scan the
+        /// constraints without Concert iterators. The non-binary variables
+        /// of each row are summarized by the sums of their positive and
+        /// negative coefficients. It also holds the (filtered) constraints
+        /// of each binary variable, in compressed sparse column format.
+        class BinaryConstraintMatrix {
+            public:
+                /// Start of each row in index and coef. Size: rows + 1.
+                vector<size_t> row_begin;
+
+                /// Binary variable of each non-zero.
+                vector<int> index;
+
+                /// Coefficient of each non-zero.
+                vector<double> coef;
+
+                /// Type of each row: 'l' (<=), 'g' (>=), 'e' (=),
+                /// or 'r' (range, not supported).
+                vector<char> type;
+
+                /// Lower and upper bounds of each row.
+                vector<UpperLowerBounds> bounds;
+
+                /// Sum of the positive coefficients of the non-binary
+                /// variables of each row.
+                vector<double> other_positive;
+
+                /// Sum of the negative coefficients of the non-binary
+                /// variables of each row.
+                vector<double> other_negative;
+
+                /// Start of each binary variable in rows. Size: binaries + 1.
+                vector<size_t> column_begin;
+
+                /// The most important rows of each binary variable,
+                /// according to the constraint filtering.
+                vector<int> rows;
+
+                BinaryConstraintMatrix():
+                    row_begin(), index(), coef(), type(), bounds(),
+                    other_positive(), other_negative(), column_begin(), rows()
+                {}
+        };
+
+        /// Projection LP of one thread without the fixed binary variables.
+        /// See FeasibilityPump_Decoder::buildReducedModels().
+        class ReducedModel {
+            public:
+                IloModel model;             ///< The reduced model.
+                IloCplex cplex;             ///< CPLEX algorithm.
+                IloRangeArray rows;         ///< Rows not made redundant.
+                IloObjective objective;     ///< Feasibility pump objective.
+                IloExpr original_expr;      ///< Original objective (free vars).
+                IloNumVarArray binaries;    ///< The free binary variables.
+                IloNumArray values;         ///< Values of the free binaries.
+                IloConversion relaxer;      ///< Relax the free variables.
+
+                ReducedModel():
+                    model(), cplex(), rows(), objective(), original_expr(),
+                    binaries(), values(), relaxer()
+                {}
+        };
+
+        /// A cut of the rounding cut pool attached to a projection LP.
+        class AttachedCut {
+            public:
+                /// The cut in the pool. We keep a raw pointer because the
+                /// reference counting of dominiqs::CutPtr is not thread safe.
+                /// The cut is detached before being purged from the pool.
+                const dominiqs::Cut* cut;
+                IloRange range;         ///< The cut in the LP.
+                unsigned slack_age;     ///< Consecutive projections where it was slack.
+                AttachedCut(): cut(nullptr), range(), slack_age(0) {}
+                AttachedCut(const dominiqs::Cut* _cut, const IloRange& _range):
+                    cut(_cut), range(_range), slack_age(0) {}
+        };
         //@}
 
         /** \name General constant attributes */
@@ -507,19 +841,47 @@ class FeasibilityPump_Decoder: public BRKGA_Decoder {
         /// from Domenico Salvagnin.
         vector<dominiqs::SolutionTransformerPtr> frac2int_per_thread;
 
-        /// Cuts from infeasible rounndings inserted during the optimization.
-        vector<IloConstraintArray> cuts_per_thread;
+        /// Cuts of the pool attached to the projection LP (full or reduced).
+        vector<vector<AttachedCut>> attached_cuts_per_thread;
+
+        /// Projection LPs without the fixed variables, used while
+        /// reduced_models_active is set.
+        vector<ReducedModel> reduced_model_per_thread;
+
+        /// Instant in which the current decoding must stop (see
+        /// setDecodeTimeBudget()).
+        vector<std::chrono::steady_clock::time_point> decode_deadline_per_thread;
+
+        /// Wall times, in seconds, of the last DECODE_TIME_WINDOW decodings
+        /// (circular buffer, indexed by num_decodes_per_thread).
+        vector<vector<double>> decode_times_per_thread;
+
+        /// Number of decodings performed by each thread.
+        vector<size_t> num_decodes_per_thread;
         //@}
 
         /** \name Other attributes */
         //@{
-        /// Keeps the cuts (and hash values) from roudings the lead to
-        /// infeasible solutions. The cuts are associated to the thread 0
-        /// CPLEX objects.
-        unordered_map<size_t, IloConstraint> rounding_cuts;
+        /// Keeps the cuts from roudings the lead to infeasible solutions,
+        /// over the indices of binary_variables_per_thread. The cut
+        /// signatures are the hashes of the roundings.
+        dominiqs::CutPool rounding_cut_pool;
+
+        /// Maximum number of cuts attached to each projection LP.
+        unsigned max_attached_cuts;
+
+        /// Number of consecutive projections in which an attached cut may
+        /// be slack before being removed from the LP.
+        unsigned max_cut_slack_age;
 
-        /// Maps the most important constraints to each binary variable.
-        vector<vector<IloRange>> constraints_per_variable;
+        /// Keeps the lazy constraints (and hash values) given to the MIP
+        /// local search. The cuts are associated to the thread 0 CPLEX
+        /// objects.
+        unordered_map<size_t, IloConstraint> local_search_cuts;
+
+        /// The constraints over the binary variables, and the most
+        /// important constraints of each binary variable.
+        BinaryConstraintMatrix constraint_matrix;
 
         /// Hold the values of the LP relaxation for all variables
         vector<IloNum> full_relaxation_variable_values;
@@ -573,7 +935,69 @@ class FeasibilityPump_Decoder: public BRKGA_Decoder {
         /// Holds the original bounds of binary variables after
         /// constraint propagation.
         vector<UpperLowerBounds> binary_variables_bounds;
-        //@}
+
+        /// Defines the decomposition of the MIP local search.
+        DecompositionType mip_local_search_decomposition;
+
+        /// The cluster of each binary variable, or -1 if the variable
+        /// belongs to no cluster. Used with DecompositionType::CLUSTERS.
+        vector<int> cluster_per_binary;
+
+        /// Indicates that the MIP local search must stop.
+        /// See FeasibilityPump_Decoder::abortMIPLocalSearch().
+        std::atomic<bool> mip_local_search_abort;
+
+        /// Neighbourhoods raced in the MIP local search.
+        vector<NeighbourhoodParams> mip_local_search_portfolio;
+
+        /// Indicates that a neighbourhood of the portfolio found a
+        /// feasible solution, so the others must stop.
+        std::atomic<bool> portfolio_solved;
+
+        /// Number of elite roundings given as MIP starts to the sub-MIPs.
+        /// See FeasibilityPump_Decoder::setNumMIPStarts().
+        unsigned num_mip_starts;
+
+        /// Roundings of the binaries of the elite chromosomes, used as MIP
+        /// starts in the current local search or probing.
+        vector<vector<int8_t>> elite_roundings;
+
+        /// Indicates that the projection LPs must be reduced after a
+        /// successful variable fixing. See setReducedModels().
+        bool reduced_models;
+
+        /// Indicates that the reduced models are built and used by
+        /// the feasibility pump.
+        bool reduced_models_active;
+
+        /// Maps the variables of ReducedModel::binaries to their indices
+        /// in binary_variables_per_thread (i.e., to the genes).
+        vector<IloInt> reduced_to_full;
+
+        /// Maps the indices in binary_variables_per_thread to the indices
+        /// in ReducedModel::binaries, or -1 if the variable is fixed.
+        vector<IloInt> full_to_reduced;
+
+        /// Number of rows of the reduced models (without cuts).
+        size_t num_reduced_rows;
+
+        /// Deterministic work limit (ticks) of each projection LP.
+        /// See setLPWorkLimit().
+        double lp_work_limit;
+
+        /// Time budget factor of each decoding. See setDecodeTimeBudget().
+        double decode_budget_factor;
+
+        /// Threads of the component-parallel rounding of each decoding.
+        /// See setComponentRoundingThreads().
+        unsigned component_rounding_threads;
+
+        /// Time limit (seconds) of the probing of the propagation rounding.
+        /// See setRoundingProbing().
+        double rounding_probing_time;
+
+        /// Number of decodings used to compute the median decoding time.
+        static const size_t DECODE_TIME_WINDOW;
 
         /** Some statistical data */
         //@{
@@ -581,9 +1005,34 @@ class FeasibilityPump_Decoder: public BRKGA_Decoder {
         /// to avoid race conditions but sum all in the end.
         vector<unsigned> solved_lps_per_thread;
 
+        /// Accumulates the number of decodings cut short by the LP work
+        /// limit or the decoding budget, per thread.
+        vector<unsigned> cut_short_decodes_per_thread;
+
         /// Indicates is a feasible solution was found before unfix variables
         /// during the local MIP search.
         bool feasible_before_var_unfixing;
+
+        /// Number of sub-MIPs solved in the last decomposed MIP local search.
+        unsigned num_subproblems;
+
+        /// Number of these sub-MIPs with a feasible solution.
+        unsigned num_feasible_subproblems;
+
+        /// Index of the neighbourhood of the portfolio that found a feasible
+        /// solution in the last MIP local search, or -1 if none.
+        int portfolio_winner;
+
+        /// Number of sub-MIPs (and probings) solved with MIP starts.
+        std::atomic<unsigned> num_started_subproblems;
+
+        /// Number of these sub-MIPs whose first incumbent was a MIP start,
+        /// as given.
+        std::atomic<unsigned> num_mip_starts_accepted;
+
+        /// Number of these sub-MIPs whose first incumbent was a MIP start
+        /// repaired or completed by CPLEX.
+        std::atomic<unsigned> num_mip_starts_repaired;
         //@}
 
     protected:
@@ -645,7 +1094,7 @@ class FeasibilityPump_Decoder: public BRKGA_Decoder {
 
         /** \name Initialization helper methods */
         //@{
-        /// \brief Build FeasibilityPump_Decoder::constraints_per_variable.
+        /// \brief Build FeasibilityPump_Decoder::constraint_matrix
         /// data structures.
         void buildConstraint2VariableMatrix();
 
@@ -656,6 +1105,28 @@ class FeasibilityPump_Decoder: public BRKGA_Decoder {
 
         /** \name Fixing helper methods */
         //@{
+        /** \brief Change the bounds of several binary variables at once.
+         *
+         * Instead of one Concert call (and model notification) per
+         * variable, the changes are applied to each model with one
+         * array-based bound change. When all threads are changed, their
+         * models are updated in parallel.
+         * \param indices the variables (indices in binary_variables_per_thread).
+         * \param bounds the new bounds of each variable.
+         * \param thread the thread whose model is changed, or -1 for all.
+         */
+        void setBinaryBounds(const vector<IloInt>& indices,
+                             const vector<UpperLowerBounds>& bounds,
+                             const int thread = -1);
+
+        /** \brief Apply a fixing to all binary variables at once.
+         * The free variables get back their original bounds
+         * (FeasibilityPump_Decoder::binary_variables_bounds).
+         * \param fixing the fixing of each binary (0, 1, or -1 if free).
+         * \param thread the thread whose model is changed, or -1 for all.
+         */
+        void setBinaryFixing(const vector<int8_t>& fixing, const int thread = -1);
+
         /** \brief This is a recursive function to fix variables.
          * It works in divide and conquer fashion. First, the function tries to
          * fix all variables in the interval [begin, end]. If it has success,
@@ -697,6 +1168,168 @@ class FeasibilityPump_Decoder: public BRKGA_Decoder {
                           vector<UpperLowerBounds>& old_bounds,
                           unsigned& num_fixings);
         //@}
+
+        /** \name Reduced model helper methods */
+        //@{
+        /** \brief Build the reduced models from the current fixing
+         * (fixed_vars). Does nothing if no variable is fixed.
+         */
+        void buildReducedModels();
+
+        /// Release the reduced models and go back to the full ones.
+        void clearReducedModels();
+
+        //@}
+
+        /** \name Rounding cut helper methods */
+        //@{
+        /** \brief Age the cuts attached to the projection LP of a thread and
+         * attach the cuts of the pool violated by the LP solution.
+         * \param thread the thread.
+         * \param values the LP values of all binaries.
+         * \param age_cuts if true, count the slack attached cuts and remove
+         *        the old ones. Only the first LP of a projection must age
+         *        the cuts, so that the separation rounds end.
+         * \return true if some cut was attached, and so, the LP must be
+         *         solved again.
+         */
+        bool separateRoundingCuts(const int thread, const IloNumArray& values,
+                                  const bool age_cuts);
+
+        /** \brief Build the LP row of a cut for the projection LP of a
+         * thread, substituting the fixed variables if the reduced models
+         * are active.
+         */
+        IloRange buildRoundingCut(const int thread, const dominiqs::Cut& cut);
+
+        /** \brief Remove cuts from the projection LPs.
+         * \param only_purged if true, remove only the cuts that are not in
+         *        the pool anymore. Otherwise, remove all.
+         */
+        void detachRoundingCuts(const bool only_purged = false);
+        //@}
+
+        /** \name MIP local search helper methods */
+        //@{
+        /** \brief Split the free binary variables in parts to be solved as
+         * independent sub-MIPs, according to
+         * FeasibilityPump_Decoder::mip_local_search_decomposition.
+         * \param local_fixed the fixing of each binary (0, 1, or -1 if free).
+         * \return the lists of binary variable indices of each part.
+         */
+        vector<vector<IloInt>> buildSubproblems(const vector<int8_t>& local_fixed);
+
+        /** \brief Solve the parts of the neighbourhood as concurrent sub-MIPs
+         * and verify the merged solution on thread 0.
+         *
+         * If the merged solution is infeasible, the variables of the parts
+         * with feasible solution are fixed in thread 0 (and local_fixed)
+         * to be used in the global sub-MIP.
+         *
+         * Each sub-MIP drops the rows whose free binaries are all in other
+         * parts, and does not fix the free binaries of the other parts.
+         *
+         * \param max_time in seconds, for each sub-MIP.
+         * \param[in, out] local_fixed the fixing of each binary.
+         * \param[in, out] num_unfixed_vars number of free binaries.
+         * \return true if the merged solution is feasible. In this case, the
+         *         solution can be read from thread 0 CPLEX object.
+         */
+        bool performDecomposedMIPLocalSearch(const double max_time,
+                                             vector<int8_t>& local_fixed,
+                                             size_t& num_unfixed_vars);
+
+        /** \brief Race the neighbourhoods of the portfolio.
+         * Parameters as in performMIPLocalSearch().
+         * \return true if some neighbourhood found a feasible solution.
+         */
+        bool racePortfolio(const Population& population,
+                           const unsigned num_chromosomes,
+                           const double max_time,
+                           Chromosome& possible_feasible,
+                           size_t& num_unfixed_vars);
+
+        /** \brief Verify if a constraint is violated by a partial fixing,
+         * i.e., even the free variables cannot satisfy it.
+         * \param row the constraint index in constraint_matrix.
+         * \param local_fixed the fixing of each binary (0, 1, or -1 if free).
+         * \param[out] hash_value hash of the binaries fixed to one in the row.
+         * \throw std::runtime_error for ranged constraints.
+         */
+        bool isViolatedByFixing(const size_t row,
+                                const vector<int8_t>& local_fixed,
+                                size_t& hash_value) const;
+
+        /** \brief Find, in parallel, the constraints violated by a partial
+         * fixing, from the minimum and maximum activities of each row.
+         * Since unfixing variables only relaxes the rows, the constraints
+         * violated after some unfixing are a subset of these ones.
+         * \param local_fixed the fixing of each binary (0, 1, or -1 if free).
+         * \param[out] candidates 1 if the row is violated (or is a range),
+         *       0 otherwise.
+         */
+        void findViolatedRows(const vector<int8_t>& local_fixed,
+                              vector<uint8_t>& candidates) const;
+
+        /** \brief Build the neighbourhood of the MIP local search without
+         * touching the models: fix the variables from the histogram of the
+         * roundings, unfix the variables that may repair the violated
+         * constraints, and then, unfix unfix_level levels of neighbours.
+         * \param population the chromosomes.
+         * \param num_chromosomes the number of chromosomes to be considered.
+         * \param discrepancy the discrepancy level.
+         * \param unfix_level the levels of neighbours to be unfixed.
+         * \param[out] local_fixed the fixing of each binary.
+         * \return the number of free binaries.
+         */
+        size_t buildNeighbourhood(const Population& population,
+                                  const unsigned num_chromosomes,
+                                  const double discrepancy,
+                                  const unsigned unfix_level,
+                                  vector<int8_t>& local_fixed);
+
+        /** \brief Keep the roundings of the best chromosomes, without
+         * duplicates, in FeasibilityPump_Decoder::elite_roundings.
+         * \param population the chromosomes.
+         * \param num_chromosomes the number of chromosomes to be considered.
+         */
+        void collectEliteRoundings(const Population& population,
+                                   const unsigned num_chromosomes);
+
+        /** \brief Add the elite roundings as partial MIP starts, with
+         * repair, to the CPLEX object of the given thread.
+         * \param thread the thread whose CPLEX objects are used.
+         * \param fixing the fixing of each binary. Only the free ones
+         *        (-1) are given in the starts.
+         * \return the number of starts added.
+         */
+        int addEliteMIPStarts(const int thread, const vector<int8_t>& fixing);
+
+        /** \brief Update the MIP start statistics after a solve, and
+         * remove the starts from the CPLEX object of the given thread.
+         * \param thread the thread whose CPLEX objects are used.
+         * \param fixing the fixing used in addEliteMIPStarts().
+         * \param num_starts the number of starts added.
+         * \param first_source the source of the first incumbent
+         *        (IloCplex::IncumbentCallbackI::SolutionSource), or -1.
+         * \param feasible indicates if the solve found a feasible solution.
+         */
+        void accountMIPStarts(const int thread, const vector<int8_t>& fixing,
+                              const int num_starts, const int first_source,
+                              const bool feasible);
+
+        /** \brief Solve a sub-MIP on the objects of the given thread, and
+         * restore them for the decoding afterwards.
+         * \param thread the thread whose CPLEX objects are used.
+         * \param fixing the fixing of each binary (0, 1, or -1 if free).
+         * \param max_time in seconds.
+         * \param cplex_threads number of threads used by CPLEX.
+         * \return true if a feasible solution was found. Its values are
+         *         in current_values_per_thread[thread].
+         */
+        bool solveSubMIP(const int thread, const vector<int8_t>& fixing,
+                         const double max_time, const int cplex_threads);
+        //@}
 };
 
 #endif //FEASIBILITYPUMP_DECODER_HPP_
@@ -0,0 +1,180 @@
+/******************************************************************************
+ * speculative_var_fixing.hpp: Interface for SpeculativeVarFixing class.
+ *
+ * Author: Carlos Eduardo de Andrade
+ *         <carlos.andrade@gatech.edu / ce.andrade@gmail.com>
+ *
+ * (c) Copyright 2015-2019
+ *     Industrial and Systems Engineering, Georgia Institute of Technology
+ *     All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by andrade
+ *  Last update: Oct 18, 2026 by andrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+
+#ifndef SPECULATIVE_VAR_FIXING_HPP_
+#define SPECULATIVE_VAR_FIXING_HPP_
+
+#include "feasibility_pump_decoder.hpp"
+#include "population.hpp"
+#include "chromosome.hpp"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+
+#include <boost/timer/timer.hpp>
+
+/**
+ * \brief Probes the next variable fixing in background.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * FeasibilityPump_Decoder::analyzeAndFixVars() blocks the BRKGA during the
+ * fixing and its CPLEX probing, even when the probing proves the fixing
+ * infeasible. This class runs analyzeAndFixVars() in a separated thread,
+ * on a snapshot of the population and on the models of a probe decoder
+ * (a clone of the instance), while the BRKGA evolves under the current
+ * bounds. Only when the probing succeeds, collect() commits the fixing
+ * to all threads of the decoder used by the BRKGA
+ * (FeasibilityPump_Decoder::applyFixing()). So, a failed speculation
+ * costs the BRKGA nothing.
+ *
+ * The number of threads of the probe decoder is the number of threads
+ * used by the CPLEX probing. Therefore, the decoder used by the BRKGA must
+ * be built with the remaining threads.
+ */
+class SpeculativeVarFixing {
+    public:
+        /** \name Constructor and Destructor */
+        //@{
+        /** \brief Default Constructor.
+         * \param probe_decoder a decoder used only by the probing. It must
+         *        be initialized (FeasibilityPump_Decoder::init()).
+         * \param decoder the decoder that receives the successful fixings.
+         */
+        SpeculativeVarFixing(FeasibilityPump_Decoder& probe_decoder,
+                             FeasibilityPump_Decoder& decoder);
+
+        /// Destructor. Cancels and waits a running probing.
+        ~SpeculativeVarFixing();
+        //@}
+
+        /** \name Main methods */
+        //@{
+        /** \brief Launch the fixing and probing on a copy of the population.
+         * Parameters as in FeasibilityPump_Decoder::analyzeAndFixVars().
+         * \param population the chromosomes (copied).
+         * \param num_chromosomes the number of chromosomes to be considered.
+         * \param fixing the type of fixing.
+         * \param fixing_percentage the percentage of binaries to be fixed.
+         * \return false if a probing is already running or
+         *         was not collected yet.
+         */
+        bool launch(const Population& population,
+                    const unsigned num_chromosomes,
+                    const FeasibilityPump_Decoder::FixingType fixing,
+                    const double fixing_percentage);
+
+        /** \brief Wait for the probing and get its results. If the fixing
+         * worked, it is committed to the decoder.
+         * \param[out] possible_feasible the feasible solution, if the
+         *             probing found one (num_non_integral_vars == 0).
+         * \param[out] num_fixings the number of variables fixed.
+         * \return true if the fixing worked.
+         * \throw the exception thrown by the probing, if any.
+         */
+        bool collect(Chromosome& possible_feasible, unsigned& num_fixings);
+
+        /// Ask the probing to stop and wait for it. The results are
+        /// discarded.
+        void cancel();
+        //@}
+
+        /** \name Informational methods */
+        //@{
+        /// Indicates if a probing was launched and not collected yet.
+        inline bool isActive() const {
+            return worker.joinable();
+        }
+
+        /// Indicates if the probing finished and can be collected
+        /// without waiting. Reset by collect() and cancel().
+        inline bool hasFinished() const {
+            return finished;
+        }
+
+        /// Percentage of binaries of the last launched fixing.
+        inline double getFixingPercentage() const {
+            return fixing_percentage;
+        }
+
+        /// Time spent by the last collected probing.
+        inline const boost::timer::cpu_times& getLastTime() const {
+            return last_time;
+        }
+        //@}
+
+    private:
+        /** \name Disabled methods */
+        //@{
+        SpeculativeVarFixing(const SpeculativeVarFixing&) = delete;
+        SpeculativeVarFixing& operator=(const SpeculativeVarFixing&) = delete;
+        //@}
+
+    protected:
+        /** \name Data members */
+        //@{
+        /// The decoder used only by the probing.
+        FeasibilityPump_Decoder& probe_decoder;
+
+        /// The decoder that receives the successful fixings.
+        FeasibilityPump_Decoder& decoder;
+
+        /// The thread running the probing.
+        std::thread worker;
+
+        /// Indicates that the probing finished.
+        std::atomic<bool> finished;
+
+        /// Copy of the population taken on launch().
+        std::unique_ptr<Population> snapshot;
+
+        /// The solution found by the probing.
+        Chromosome solution;
+
+        /// Indicates if the fixing worked.
+        bool worked;
+
+        /// Number of variables fixed by the probing.
+        unsigned num_fixings;
+
+        /// Percentage of binaries of the last launched fixing.
+        double fixing_percentage;
+
+        /// Exception thrown by the probing, if any.
+        std::exception_ptr error;
+
+        /// Time spent by the last probing.
+        boost::timer::cpu_times last_time;
+        //@}
+};
+
+#endif //SPECULATIVE_VAR_FIXING_HPP_
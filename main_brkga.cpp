@@ -9,7 +9,7 @@
  *     All Rights Reserved.
  *
  *  Created on : Feb 18, 2015 by andrade
- *  Last update: Ago 21, 2015 by andrade
+ *  Last update: Oct 18, 2026 by andrade
  *
  * This code is released under LICENSE.md.
  *
@@ -30,6 +30,9 @@
 #include "mtrand.hpp"
 #include "brkga.hpp"
 #include "execution_stopper.hpp"
+#include "async_mip_local_search.hpp"
+#include "speculative_var_fixing.hpp"
+#include "clusterator.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -38,10 +41,10 @@
 #include <algorithm>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <utility>
 #include <cstdlib>
 #include <cmath>
-#include <unordered_set>
 #include <vector>
 
 #include "pragma_diagnostic_ignored_header.hpp"
@@ -53,6 +56,7 @@
 
 using namespace std;
 using namespace BRKGA_ALG;
+using namespace ce_andrade;
 
 const double EPS = 1e-6;
 
@@ -95,7 +99,27 @@ void show_usage_info(const char* exec_name, bool full) {
     }
     else
     cerr << "\nwhere: "
-         << "\n - <config-file>: parameters of BRKGA algorithm."
+         << "\n - <config-file>: parameters of BRKGA algorithm. Twelve optional lines may"
+         << "\n   follow the reset interval: the crossover type (0: uniform; 1: blocks of"
+         << "\n   clustered binary variables, inherited as a whole), the maximum"
+         << "\n   sharing distance inside a cluster (in [0,1], default 0.5), and the"
+         << "\n   decomposition of the MIP local search (0: none; 1: connected components"
+         << "\n   of the free variables; 2: clusters of variables) in concurrent sub-MIPs,"
+         << "\n   and the number of threads of an asynchronous MIP local search running"
+         << "\n   alongside the BRKGA (0: synchronous local search, using all threads),"
+         << "\n   and the portfolio of the MIP local search (0: one neighbourhood; 1: race"
+         << "\n   discrepancy levels {0, 0.05, 0.15} x unfix levels {0, 1, 2}, up to the"
+         << "\n   number of threads of the local search), the number of elite"
+         << "\n   roundings given to CPLEX as MIP starts (0: none), the reduction of the"
+         << "\n   projection LPs after a variable fixing (0: no; 1: yes), and the"
+         << "\n   speculative variable fixing, probed by one background thread while"
+         << "\n   the BRKGA evolves (0: no, synchronous fixing; 1: yes), the time budget"
+         << "\n   of each decoding as a multiple of the median decoding time (0: none),"
+         << "\n   the deterministic work limit of each projection LP, in CPLEX ticks"
+         << "\n   (0: none), the threads rounding the independent blocks of"
+         << "\n   variables of each decoding, capped by the processors (0: sequential),"
+         << "\n   and the time limit of the probing of the propagation rounding, in"
+         << "\n   seconds (0: no probing)."
          << "\n - <seed>: seed for random generator."
          << "\n - <stop-rule> <stop-arg>: stop rule and its arguments where:"
          << "\n\t+ (G)enerations <number_generations>: the algorithm runs until <number_generations>;"
@@ -188,6 +212,25 @@ void show_usage_info(const char* exec_name, bool full) {
          << endl;
 }
 
+//-------------------------[ Config file functions ]--------------------------//
+
+/// Read an optional parameter of the config file, in its own line.
+/// After the first missing parameter, the stream fails and all the
+/// following ones are missing too, keeping their default values.
+/// \param fin the config file, without exceptions enabled.
+/// \param value the parameter. Not changed if missing.
+/// \return false if the parameter is missing.
+template <typename T>
+bool readOptional(ifstream &fin, T &value) {
+    T tmp;
+    if(!(fin >> tmp))
+        return false;
+
+    value = tmp;
+    fin.ignore(numeric_limits<streamsize>::max(), '\n');
+    return true;
+}
+
 //--------------------------------[ Main ]------------------------------------//
 
 int main(int argc, char* argv[]) {
@@ -400,6 +443,18 @@ int main(int argc, char* argv[]) {
     unsigned exchange_interval;         // interval at which elite chromosomes are exchanged (0 means no exchange)
     unsigned num_exchange_indivuduals;  // number of elite chromosomes to obtain from each population
     unsigned reset_interval;            // interval at which the populations are reset (0 means no reset)
+    bool cluster_block_crossover;       // crossover inherits clusters of variables as blocks (optional)
+    double cluster_compaction_distance; // max. sharing distance inside a block (optional)
+    FeasibilityPump_Decoder::DecompositionType miplocalsearch_decomposition; // (optional)
+    unsigned miplocalsearch_thread_share; // threads of the async. local search (optional)
+    bool miplocalsearch_portfolio;      // race several neighbourhoods (optional)
+    unsigned num_mip_starts;            // elite roundings used as MIP starts (optional)
+    bool reduced_models;                // reduce the projection LPs after fixing (optional)
+    bool speculative_fixing;            // probe the fixings in background (optional)
+    double decode_budget_factor;        // budget of each decoding (optional)
+    double lp_work_limit;               // work limit of each projection LP (optional)
+    unsigned component_rounding_threads; // threads rounding the blocks of each decoding (optional)
+    double rounding_probing_time;       // time limit of the rounding probing (optional)
 
     // Loading algorithm parameters from config file (code from rtoso).
     ifstream fin(configFile, std::ios::in);
@@ -422,6 +477,56 @@ int main(int argc, char* argv[]) {
         fin >> exchange_interval;           getline(fin, line);
         fin >> num_exchange_indivuduals;    getline(fin, line);
         fin >> reset_interval;
+
+        // Optional parameters, missing in older config files.
+        cluster_compaction_distance = 0.5;
+        miplocalsearch_decomposition = FeasibilityPump_Decoder::DecompositionType::NONE;
+        miplocalsearch_thread_share = 0;
+        num_mip_starts = 0;
+        decode_budget_factor = 0.0;
+        lp_work_limit = 0.0;
+        component_rounding_threads = 0;
+        rounding_probing_time = 0.0;
+        fin.exceptions(ifstream::goodbit);
+        getline(fin, line);
+
+        unsigned crossover_type = 0;
+        unsigned decomposition_type = 0;
+        unsigned portfolio = 0;
+        unsigned reduce = 0;
+        unsigned speculative = 0;
+
+        readOptional(fin, crossover_type);
+        readOptional(fin, cluster_compaction_distance);
+        readOptional(fin, decomposition_type);
+        readOptional(fin, miplocalsearch_thread_share);
+        readOptional(fin, portfolio);
+        readOptional(fin, num_mip_starts);
+        readOptional(fin, reduce);
+        readOptional(fin, speculative);
+        readOptional(fin, decode_budget_factor);
+        readOptional(fin, lp_work_limit);
+        readOptional(fin, component_rounding_threads);
+        readOptional(fin, rounding_probing_time);
+
+        cluster_block_crossover = (crossover_type == 1);
+        miplocalsearch_portfolio = (portfolio == 1);
+        reduced_models = (reduce == 1);
+        speculative_fixing = (speculative == 1);
+
+        switch(decomposition_type) {
+        case 1:
+            miplocalsearch_decomposition =
+                FeasibilityPump_Decoder::DecompositionType::COMPONENTS;
+            break;
+        case 2:
+            miplocalsearch_decomposition =
+                FeasibilityPump_Decoder::DecompositionType::CLUSTERS;
+            break;
+        default:
+            break;
+        }
+
         fin.close();
     }
     catch(ifstream::failure& e) {
@@ -430,6 +535,19 @@ int main(int argc, char* argv[]) {
         return 65;  // BSD file read error code
     }
 
+    if(miplocalsearch_thread_share >= num_threads) {
+        cerr << "The threads of the asynchronous MIP local search must be "
+             << "less than the number of threads." << endl;
+        return 65;
+    }
+
+    if(speculative_fixing &&
+       miplocalsearch_thread_share + 1 >= num_threads) {
+        cerr << "The speculative variable fixing needs one thread besides "
+             << "the decoding and asynchronous MIP local search threads." << endl;
+        return 65;
+    }
+
     //-----------------------------------------//
     // Tuning
     //-----------------------------------------//
@@ -476,6 +594,9 @@ int main(int argc, char* argv[]) {
                  << "\n>    + interval of chromosome exchange: " << exchange_interval
                  << "\n>    + # of elite chromosome of each population: " << num_exchange_indivuduals
                  << "\n>    + reset interval: " << reset_interval
+                 << "\n>    + crossover: "
+                 << (cluster_block_crossover? "cluster blocks" : "uniform")
+                 << "\n>    + cluster compaction distance: " << cluster_compaction_distance
                  << "\n> Seed: " << seed
                  << "\n> Stop Rule: "
                  << (stop_rule == StopRule::GENERATIONS ? "Generations -> " :
@@ -543,6 +664,48 @@ int main(int argc, char* argv[]) {
                  << "\n>\t- discrepancy_level: " << miplocalsearch_discrepancy_level
                  << "\n>\t- unfix_levels: " << miplocalsearch_unfix_levels
                  << "\n>\t- max_time: " << miplocalsearch_max_time
+                 << "\n>\t- decomposition: "
+                 << (miplocalsearch_decomposition == FeasibilityPump_Decoder::DecompositionType::NONE?
+                     "none" :
+                    (miplocalsearch_decomposition == FeasibilityPump_Decoder::DecompositionType::COMPONENTS?
+                     "connected components" : "clusters of variables"))
+                 << "\n>\t- asynchronous: ";
+
+        if(miplocalsearch_thread_share > 0)
+            log_file << miplocalsearch_thread_share << " threads";
+        else
+            log_file << "no";
+
+        log_file << "\n>\t- portfolio: " << (miplocalsearch_portfolio? "yes" : "no")
+                 << "\n>\t- MIP starts: " << num_mip_starts
+                 << "\n>\t- reduced LPs after fixing: " << (reduced_models? "yes" : "no")
+                 << "\n>\t- speculative fixing: " << (speculative_fixing? "yes" : "no");
+
+        log_file << "\n> Decoding budget: ";
+        if(decode_budget_factor > 0.0)
+            log_file << decode_budget_factor << "x the median decoding time";
+        else
+            log_file << "none";
+
+        log_file << "\n> LP work limit: ";
+        if(lp_work_limit > 0.0)
+            log_file << lp_work_limit << " ticks";
+        else
+            log_file << "none";
+
+        log_file << "\n> Component-parallel rounding: ";
+        if(component_rounding_threads > 1)
+            log_file << component_rounding_threads << " threads per decoding";
+        else
+            log_file << "no";
+
+        log_file << "\n> Rounding probing: ";
+        if(rounding_probing_time > 0.0)
+            log_file << rounding_probing_time << " seconds";
+        else
+            log_file << "no";
+
+        log_file
                  << "\n>\t- constraint_filtering: ";
 
         switch(constraint_filtering) {
@@ -563,7 +726,12 @@ int main(int argc, char* argv[]) {
         // Load instance
         ////////////////////////////////////////////
 
-        FeasibilityPump_Decoder decoder(instance_file, num_threads, seed,
+        // When the MIP local search runs asynchronously, it takes its
+        // threads from the decoding. So does the speculative fixing.
+        const unsigned decoding_threads = num_threads - miplocalsearch_thread_share -
+                                          (speculative_fixing? 1 : 0);
+
+        FeasibilityPump_Decoder decoder(instance_file, decoding_threads, seed,
                                         pump_strategy,
                                         fitness_type,
                                         minimization_factor,
@@ -576,17 +744,100 @@ int main(int argc, char* argv[]) {
                                         constraint_filtering,
                                         miplocalsearch_discrepancy_level);
 
-        if(roundcuts_percentage > 0.0)
-            decoder.rounding_cuts.reserve(10000);
-
         log_file << "\n\n-----------------------------"
                  << "\n>>>> Initializing the decoder..." << endl;
 
         ExecutionStopper::timerStart();
         local_timer.start();
+        decoder.setComponentRoundingThreads(component_rounding_threads);
+        decoder.setRoundingProbing(rounding_probing_time);
         decoder.init();
         //decoder.setAlleleThreshold(decoder.getZerosPercentageInInitialRelaxation());
 
+        // The asynchronous local search has its own decoder, and so, its
+        // own CPLEX environments.
+        unique_ptr<FeasibilityPump_Decoder> local_search_decoder;
+        unique_ptr<AsyncMIPLocalSearch> async_local_search;
+
+        if(miplocalsearch_thread_share > 0) {
+            local_search_decoder.reset(
+                new FeasibilityPump_Decoder(instance_file,
+                                            miplocalsearch_thread_share, seed,
+                                            pump_strategy,
+                                            fitness_type,
+                                            minimization_factor,
+                                            minimization_factor_decay,
+                                            fp_params,
+                                            objective_fp_params,
+                                            var_fixing_percentage,
+                                            var_fixing_growth_rate,
+                                            var_fixing_type,
+                                            constraint_filtering,
+                                            miplocalsearch_discrepancy_level));
+            local_search_decoder->init();
+            async_local_search.reset(new AsyncMIPLocalSearch(*local_search_decoder));
+        }
+
+        // The speculative fixing probes on a clone of the instance, with
+        // one thread.
+        unique_ptr<FeasibilityPump_Decoder> probe_decoder;
+        unique_ptr<SpeculativeVarFixing> speculative_fixer;
+
+        if(speculative_fixing) {
+            probe_decoder.reset(
+                new FeasibilityPump_Decoder(instance_file, 1, seed,
+                                            pump_strategy,
+                                            fitness_type,
+                                            minimization_factor,
+                                            minimization_factor_decay,
+                                            fp_params,
+                                            objective_fp_params,
+                                            var_fixing_percentage,
+                                            var_fixing_growth_rate,
+                                            var_fixing_type,
+                                            constraint_filtering,
+                                            miplocalsearch_discrepancy_level));
+            probe_decoder->init();
+            speculative_fixer.reset(new SpeculativeVarFixing(*probe_decoder, decoder));
+        }
+
+        decoder.setNumMIPStarts(num_mip_starts);
+        decoder.setReducedModels(reduced_models);
+        decoder.setDecodeTimeBudget(decode_budget_factor);
+        decoder.setLPWorkLimit(lp_work_limit);
+        if(local_search_decoder)
+            local_search_decoder->setNumMIPStarts(num_mip_starts);
+        if(probe_decoder)
+            probe_decoder->setNumMIPStarts(num_mip_starts);
+
+        // Neighbourhoods raced by the local search, as many as its threads.
+        vector<FeasibilityPump_Decoder::NeighbourhoodParams> portfolio;
+        if(miplocalsearch_portfolio) {
+            const unsigned max_racers = (miplocalsearch_thread_share > 0)?
+                                        miplocalsearch_thread_share : decoding_threads;
+
+            for(const unsigned unfix_level : {0u, 1u, 2u})
+                for(const double discrepancy : {0.0, 0.05, 0.15})
+                    if(portfolio.size() < max_racers)
+                        portfolio.push_back({discrepancy, unfix_level});
+
+            if(local_search_decoder)
+                local_search_decoder->setMIPLocalSearchPortfolio(portfolio);
+            else
+                decoder.setMIPLocalSearchPortfolio(portfolio);
+        }
+
+        // Describes the neighbourhood that won the last local search race.
+        auto portfolio_winner = [&portfolio](const FeasibilityPump_Decoder& ls_decoder) {
+            stringstream ss;
+            if(ls_decoder.portfolio_winner > -1) {
+                const auto &params = portfolio[ls_decoder.portfolio_winner];
+                ss << ", won by discrepancy " << params.discrepancy_level
+                   << " / unfix level " << params.unfix_level;
+            }
+            return ss.str();
+        };
+
         local_timer.stop();
         ExecutionStopper::timerStop();
         boost::timer::cpu_times preprocessing_time(local_timer.elapsed());
@@ -657,7 +908,83 @@ int main(int argc, char* argv[]) {
             algorithm(decoder.getChromosomeSize(), population_size, pe, pm, rhoe,
                       decoder, rng, num_populations,
                       BRKGA<FeasibilityPump_Decoder, MTRand>::Sense::MINIMIZE,
-                      num_threads);
+                      decoding_threads);
+
+        // Clusters of strongly linked binary variables (variables sharing
+        // constraints), used as blocks in the crossover and/or as parts of
+        // the decomposed MIP local search.
+        if(cluster_block_crossover ||
+           miplocalsearch_decomposition == FeasibilityPump_Decoder::DecompositionType::CLUSTERS) {
+            log_file << "\n\n-----------------------------"
+                     << "\n>>>> Clustering variables..." << endl;
+
+            ExecutionStopper::timerResume();
+            local_timer.start();
+
+            Clusterator clusterator;
+            clusterator.buildIncidenceMatrices(decoder.variables_per_thread[0],
+                                               decoder.constraints_per_thread[0]);
+
+            auto cluster_tree = clusterator.hierarchicalClustering(
+                                        Clusterator::ClusteringObject::VARIABLE,
+                                        Clusterator::Metric::SHARED);
+
+            cluster_tree->compactTree(ClusterTree::Compaction::BY_DISTANCE,
+                                      cluster_compaction_distance);
+
+            // Only binary variables are considered. Note that the gene j
+            // is the binary variable j.
+            vector<int> binary_of_variable(decoder.getNumVariables(), -1);
+            for(size_t j = 0; j < decoder.binary_variables_indices.size(); ++j)
+                binary_of_variable[decoder.binary_variables_indices[j]] = (int)j;
+
+            vector<vector<size_t>> clusters;
+            size_t largest_cluster = 0;
+            for(const auto node : cluster_tree->current_leaves) {
+                vector<size_t> cluster;
+                for(auto it = cluster_tree->objectsBegin(node);
+                    it != cluster_tree->objectsEnd(node); ++it) {
+                    if(binary_of_variable[*it] > -1)
+                        cluster.push_back((size_t)binary_of_variable[*it]);
+                }
+
+                if(cluster.size() > 1) {
+                    largest_cluster = max(largest_cluster, cluster.size());
+                    clusters.push_back(move(cluster));
+                }
+            }
+
+            if(cluster_block_crossover) {
+                vector<vector<unsigned>> blocks;
+                blocks.reserve(clusters.size());
+                for(const auto &cluster : clusters)
+                    blocks.emplace_back(cluster.begin(), cluster.end());
+                algorithm.setCrossoverBlocks(blocks);
+            }
+
+            if(miplocalsearch_decomposition == FeasibilityPump_Decoder::DecompositionType::CLUSTERS) {
+                decoder.setMIPLocalSearchDecomposition(miplocalsearch_decomposition, clusters);
+                if(local_search_decoder)
+                    local_search_decoder->setMIPLocalSearchDecomposition(
+                                            miplocalsearch_decomposition, clusters);
+            }
+
+            local_timer.stop();
+            ExecutionStopper::timerStop();
+
+            log_file << "\n- Compaction distance: " << cluster_compaction_distance
+                     << "\n- Num. of clusters (2+ binaries): " << clusters.size()
+                     << "\n- Largest cluster: " << largest_cluster
+                     << "\n- Clustering time: " << boost::timer::format(local_timer.elapsed());
+            log_file.flush();
+        }
+        else
+        if(miplocalsearch_decomposition == FeasibilityPump_Decoder::DecompositionType::COMPONENTS) {
+            decoder.setMIPLocalSearchDecomposition(miplocalsearch_decomposition);
+            if(local_search_decoder)
+                local_search_decoder->setMIPLocalSearchDecomposition(
+                                            miplocalsearch_decomposition);
+        }
 
         // Setting the initial population.
         log_file << "\n\n-----------------------------"
@@ -722,9 +1049,6 @@ int main(int argc, char* argv[]) {
         fixing_time.clear();
         local_search_time.clear();
 
-        unordered_set<size_t> elite_chromosomes_hashes;
-        elite_chromosomes_hashes.reserve(unsigned(population_size * pe));
-
         vector<size_t> num_unfixed_vars_per_call;
         num_unfixed_vars_per_call.reserve(20);
 
@@ -736,7 +1060,10 @@ int main(int argc, char* argv[]) {
         log_file << "\n\n-----------------------------"
                  << "\n>>>> Optimizing..."
                  << "\n> Lines starting with % represent the iteration and "
-                 << "the heterogeneity of the elite population\n\n"
+                 << "the heterogeneity of the elite population"
+                 << "\n> Lines starting with $ represent the iteration, "
+                 << "the size (num. of cuts and KB) of the rounding cut pool, "
+                 << "and the min. and max. num. of rows of the projection LPs\n\n"
                  << "Iteration | PerformanceValue | FPValue | Fractionality | "
                  << "NumNonIntegralVars | NumNonIntegralVarsPerc | "
                  << "CurrMinFactor | ChrType | "
@@ -870,19 +1197,10 @@ int main(int argc, char* argv[]) {
                                << chromosome.num_iterations << " "
                                << chromosome.feasibility_pump_value
                                << "\n";
-
-                // Hashing the rounding
-                size_t hash_value = 0;
-                for(size_t k = 0; k < (size_t)decoder.getNumBinaryVariables(); ++k) {
-                    if(chromosome.rounded[k] == 1)
-                        hash_value ^= k + 0x9e3779b9 + (hash_value << 6) + (hash_value >> 2);
-                }
-
-                elite_chromosomes_hashes.insert(hash_value);
             }
             pop_statistics.flush();
 
-            heterogeneity = (100.0 * elite_chromosomes_hashes.size()) /
+            heterogeneity = (100.0 * pop.getNumDistinctEliteRoundings(unsigned(population_size * pe))) /
                             unsigned(population_size * pe);
 
             log_file << "% " << iteration
@@ -890,8 +1208,6 @@ int main(int argc, char* argv[]) {
                      << " " << heterogeneity
                      << endl;
 
-            elite_chromosomes_hashes.clear();
-
             //////////////////////////////////////////////////////
             // Stopping controls
             //////////////////////////////////////////////////////
@@ -930,9 +1246,56 @@ int main(int argc, char* argv[]) {
             iteration_timer.resume();
             local_timer.start();
 
+            // The asynchronous local search runs on a snapshot of the
+            // population while the BRKGA evolves. Collect it when done.
+            if(async_local_search && async_local_search->hasFinished()) {
+                size_t num_unfixed_vars = 0;
+                const bool found = async_local_search->collect(best_chr,
+                                                               num_unfixed_vars);
+                num_unfixed_vars_per_call.push_back(num_unfixed_vars);
+
+                const auto &t = async_local_search->getLastTime();
+                local_search_time.wall += t.wall;
+                local_search_time.user += t.user;
+                local_search_time.system += t.system;
+
+                log_file << "--- Asynchronous MIP search: "
+                         << (found? "feasible solution found. (" :
+                                    "no feasible solution found. (")
+                         << boost::timer::format(t, 2, "%w") << " segs"
+                         << portfolio_winner(*local_search_decoder) << ")" << endl;
+
+                if(found) {
+                    feasible = feasible_from_local_search = true;
+                    break; // main loop.
+                }
+            }
+
+            if(async_local_search && !async_local_search->isActive() &&
+               best_chr.num_non_integral_vars / (double) decoder.getNumBinaryVariables()
+               < miplocalsearch_threshold) {
+                double time_limit = miplocalsearch_max_time;
+                if(time_limit < EPS) {
+                    const auto t = iteration_timer.elapsed();
+                    time_limit = max_time - ((t.user + t.system) / (1e9 * num_threads));
+                }
+
+                ++num_local_searchs;
+                async_local_search->launch(algorithm.getCurrentPopulation(),
+                                           unsigned(population_size * pe),
+                                           miplocalsearch_unfix_levels,
+                                           time_limit);
+
+                log_file << "--- Launching asynchronous MIP search on "
+                         << best_chr.num_non_integral_vars << " vars ("
+                         << (best_chr.num_non_integral_vars / (double) decoder.getNumBinaryVariables() * 100)
+                         << "%)" << endl;
+            }
+
             // Check if the number of fractional variables is low enough
             // to launch a CPLEX MIP optimization.
-            if(best_chr.num_non_integral_vars / (double) decoder.getNumBinaryVariables()
+            if(!async_local_search &&
+               best_chr.num_non_integral_vars / (double) decoder.getNumBinaryVariables()
                < miplocalsearch_threshold) {
                 log_file << "--- Launching full MIP search on "
                          << best_chr.num_non_integral_vars << " vars ("
@@ -959,15 +1322,26 @@ int main(int argc, char* argv[]) {
                      feasible = feasible_from_local_search = true;
                      log_file << "feasible solution found. ("
                               << boost::timer::format(local_timer.elapsed(), 2, "%w")
-                              << " segs)" << endl;
+                              << " segs";
+                     if(decoder.num_subproblems > 0)
+                         log_file << ", " << decoder.num_feasible_subproblems
+                                  << "/" << decoder.num_subproblems
+                                  << " feasible sub-MIPs";
+                     log_file << portfolio_winner(decoder) << ")" << endl;
 
                      num_unfixed_vars_per_call.push_back(num_unfixed_vars);
                      break; // main loop.
                  }
-                 else
+                 else {
                      log_file << "no feasible solution found. ("
                               << boost::timer::format(local_timer.elapsed(), 2, "%w")
-                              << " segs)" << endl;
+                              << " segs";
+                     if(decoder.num_subproblems > 0)
+                         log_file << ", " << decoder.num_feasible_subproblems
+                                  << "/" << decoder.num_subproblems
+                                  << " feasible sub-MIPs";
+                     log_file << ")" << endl;
+                 }
 
                 num_unfixed_vars_per_call.push_back(num_unfixed_vars);
 
@@ -991,7 +1365,75 @@ int main(int argc, char* argv[]) {
             iteration_timer.resume();
             local_timer.start();
 
-            if(decoder.variable_fixing_percentage > 0.0 &&
+            // The speculative fixing probes the next fixing on a snapshot of
+            // the population while the BRKGA evolves. Collect it when done,
+            // and commit the fixing only if it worked.
+            if(speculative_fixer && speculative_fixer->hasFinished()) {
+                const double percentage = speculative_fixer->getFixingPercentage();
+                const bool worked = speculative_fixer->collect(best_chr,
+                                                               actual_num_fixings);
+                const auto &t = speculative_fixer->getLastTime();
+
+                log_file << "--- Speculative fixing of " << (percentage * 100)
+                         << "% of the binary variables: ";
+
+                decoder.variable_fixing_percentage = percentage;
+                if(!worked) {
+                    if(var_fixing_percentage < EPS)
+                        decoder.variable_fixing_percentage /= 2;
+                    else
+                        decoder.variable_fixing_percentage *= 1 - decoder.variable_fixing_rate;
+
+                    log_file << "no success in fixing ("
+                             << boost::timer::format(t, 2, "%w")
+                             << " segs in background). Discarded." << endl;
+                }
+                else {
+                    ++num_successful_fixings;
+
+                    if(best_chr.num_non_integral_vars == 0) {
+                        feasible = feasible_from_fixing = true;
+                        log_file << "feasible solution found ("
+                                 << boost::timer::format(t, 2, "%w")
+                                 << " segs in background)" << endl;
+                        break;
+                    }
+
+                    log_file << "success. Fixed " << actual_num_fixings << " vars ("
+                             << (100.0 * actual_num_fixings / decoder.getNumBinaryVariables())
+                             << "%) (" << boost::timer::format(t, 2, "%w")
+                             << " segs in background, "
+                             << boost::timer::format(local_timer.elapsed(), 2, "%w")
+                             << " segs to commit)";
+
+                    if(decoder.isReducedModelActive())
+                        log_file << ". Reduced LPs: "
+                                 << decoder.getNumReducedBinaries() << " binaries, "
+                                 << decoder.getNumReducedRows() << " rows";
+                    log_file << endl;
+                }
+            }
+
+            if(speculative_fixer && !speculative_fixer->isActive() &&
+               decoder.variable_fixing_percentage > 0.0 &&
+               iteration % var_fixing_frequency == 0) {
+                ++num_fixings;
+
+                const double percentage =
+                        min(1.0, decoder.variable_fixing_percentage *
+                                 (1 + decoder.variable_fixing_rate));
+
+                speculative_fixer->launch(algorithm.getCurrentPopulation(),
+                                          unsigned(population_size * pe),
+                                          var_fixing_type, percentage);
+
+                log_file << "--- Launching speculative fixing of "
+                         << (percentage * 100) << "% of the binary variables"
+                         << endl;
+            }
+
+            if(!speculative_fixer &&
+               decoder.variable_fixing_percentage > 0.0 &&
                iteration % var_fixing_frequency == 0) {
                 ++num_fixings;
 
@@ -1030,11 +1472,18 @@ int main(int argc, char* argv[]) {
                                  << " segs)" << endl;
                         break;
                     }
-                    else
+                    else {
                         log_file << "success. Fixed " << actual_num_fixings << " vars ("
                                  << (100.0 * actual_num_fixings / decoder.getNumBinaryVariables())
                                  << "%) (" << boost::timer::format(local_timer.elapsed(), 2, "%w")
-                                 << " segs)" << endl;
+                                 << " segs)";
+
+                        if(decoder.isReducedModelActive())
+                            log_file << ". Reduced LPs: "
+                                     << decoder.getNumReducedBinaries() << " binaries, "
+                                     << decoder.getNumReducedRows() << " rows";
+                        log_file << endl;
+                    }
                 }
             }
 
@@ -1047,11 +1496,28 @@ int main(int argc, char* argv[]) {
             // Insert cuts based on infeasible roundings
             ////////////////////////////////////////////
 
-            if(roundcuts_percentage > 0.0)
+            if(roundcuts_percentage > 0.0) {
                 decoder.addCutsFromRoudings(algorithm.getCurrentPopulation(),
                                             unsigned(roundcuts_percentage *
                                                      population_size));
 
+                size_t min_rows = numeric_limits<size_t>::max();
+                size_t max_rows = 0;
+                for(int t = 0; t < decoder.num_threads; ++t) {
+                    const size_t rows = decoder.getNumProjectionRows(t);
+                    min_rows = min(min_rows, rows);
+                    max_rows = max(max_rows, rows);
+                }
+
+                log_file << "$ " << iteration
+                         << " " << decoder.getRoundingCutPoolSize()
+                         << setiosflags(ios::fixed) << setprecision(2)
+                         << " " << (decoder.getRoundingCutPoolMemory() / 1024.0)
+                         << " " << min_rows
+                         << " " << max_rows
+                         << endl;
+            }
+
             iteration_timer.stop();
             ExecutionStopper::timerStop();
 
@@ -1100,6 +1566,18 @@ int main(int argc, char* argv[]) {
         // End of main loop
         //////////////////////////////////////////////////////
 
+        // Either the BRKGA found a feasible solution or we are out of time.
+        // So, stop the asynchronous local search.
+        if(async_local_search && async_local_search->isActive()) {
+            async_local_search->cancel();
+            log_file << "--- Asynchronous MIP search cancelled." << endl;
+        }
+
+        if(speculative_fixer && speculative_fixer->isActive()) {
+            speculative_fixer->cancel();
+            log_file << "--- Speculative fixing cancelled." << endl;
+        }
+
         ExecutionStopper::timerStop();
         iteration_timer.stop();
         boost::timer::cpu_times elapsed_time(iteration_timer.elapsed());
@@ -1146,6 +1624,10 @@ int main(int argc, char* argv[]) {
         for(auto &v : decoder.solved_lps_per_thread)
             solved_lps += v;
 
+        unsigned cut_short_decodes = 0;
+        for(auto &v : decoder.cut_short_decodes_per_thread)
+            cut_short_decodes += v;
+
         const double solved_lps_per_decoding = solved_lps /
                 (population_size  + (population_size * (1.0 - pe) * (iteration - 1)));
 
@@ -1160,6 +1642,19 @@ int main(int argc, char* argv[]) {
 
         double final_variable_fixing_percentage = decoder.variable_fixing_percentage;
 
+        unsigned num_started_subproblems = decoder.num_started_subproblems;
+        unsigned num_mip_starts_accepted = decoder.num_mip_starts_accepted;
+        unsigned num_mip_starts_repaired = decoder.num_mip_starts_repaired;
+        if(local_search_decoder) {
+            num_started_subproblems += local_search_decoder->num_started_subproblems;
+            num_mip_starts_accepted += local_search_decoder->num_mip_starts_accepted;
+            num_mip_starts_repaired += local_search_decoder->num_mip_starts_repaired;
+        }
+        if(probe_decoder) {
+            num_mip_starts_accepted += probe_decoder->num_mip_starts_accepted;
+            num_mip_starts_repaired += probe_decoder->num_mip_starts_repaired;
+        }
+
         log_file << "\n- Optimization time: " << boost::timer::format(elapsed_time)
                  << "- Decoding time: " << boost::timer::format(decoding_time)
                  << "- Avg. decoding time: " << boost::timer::format(decoding_time_avg)
@@ -1185,9 +1680,14 @@ int main(int argc, char* argv[]) {
                  << " (" << (100.0 * avg_num_unfixed_vars_per_call / decoder.getNumBinaryVariables()) << "%)"
                  << "\n- Num. unfixed vars in the last call: " << last_num_unfixed_vars
                  << " (" << (100.0 * last_num_unfixed_vars / decoder.getNumBinaryVariables()) << "%)"
+                 << "\n- Sub-MIPs with MIP starts: " << num_started_subproblems
+                 << "\n- MIP starts accepted: " << num_mip_starts_accepted
+                 << "\n- MIP starts repaired: " << num_mip_starts_repaired
                  << "\n- Solved LPs: " << solved_lps
                  << "\n- Solved LPs per decoding: " << solved_lps_per_decoding
-                 << "\n- Rounding cuts: " << decoder.rounding_cuts.size()
+                 << "\n- Decodings cut short: " << cut_short_decodes
+                 << "\n- Rounding cuts: " << decoder.getNumRoundingCutsAdded()
+                 << "\n- Rounding cuts in the pool: " << decoder.getRoundingCutPoolSize()
                  << "\n- Viability: " << (feasible? "feasible" : "infeasible")
                  << "\n- Fractionality: " << best_chr.fractionality
                  << "\n- NumNonIntegralVars: " << best_chr.num_non_integral_vars
@@ -1445,7 +1945,7 @@ int main(int argc, char* argv[]) {
             << num_init_population << " & "
             << solved_lps << " & "
             << solved_lps_per_decoding << " & "
-            << decoder.rounding_cuts.size() << " & "
+            << decoder.getNumRoundingCutsAdded() << " & "
             << (feasible? "feasible & " : "infeasible & ")
             << (feasible_from_fixing? "yes & " : "no & ")
             << (feasible_from_local_search? "yes & " : "no & ")
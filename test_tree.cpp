@@ -32,9 +32,8 @@
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
-#include <bitset>
 #include <vector>
-#include <memory>
+#include <string>
 
 using namespace std;
 using namespace ce_andrade;
@@ -58,34 +57,32 @@ int main(int argc, char* argv[]) {
 
     int return_code = 0;
     try {
-        vector<shared_ptr<ClusterNode>> nodes(5, nullptr);
-
-        for(size_t i = 0; i < nodes.size(); ++i) {
-            nodes[i] = std::make_shared<ClusterNode>();
-            nodes[i]->original_id = i;
-        }
-
-        auto root = nodes[4];
-        root->left = nodes[3];
-        root->right = nodes[2];
-
-        nodes[3]->left = nodes[0];
-        nodes[3]->right = nodes[1];
-
-        nodes[0]->object_names.push_back("0");
-        nodes[0]->object_names.push_back("10");
-        nodes[0]->object_names.push_back("20");
-
-        nodes[1]->object_names.push_back("1");
-        nodes[2]->object_names.push_back("2");
-
-        root->print(cout);
-
-        nodes[4]->getObjectNames();
-        root->print(cout);
-
-        nodes[2]->getObjectNames();
-        root->print(cout);
+        // Leaves 0, 1, 2 and three inner nodes, as the C clustering
+        // library gives them: ((0, 1), 2).
+        vector<ClusterTree::CClusteringLibNode> plain_tree;
+        plain_tree.emplace_back(0, 1, 0.5);
+        plain_tree.emplace_back(-1, 2, 1.0);
+
+        vector<string> names {"x0", "x1", "x2"};
+        ClusterTree tree(plain_tree, names);
+
+        cout << tree;
+        tree.print(cout, tree.root);
+
+        cout << "\n\nObjects under the root: ";
+        for(auto &name : tree.getObjectNames(tree.root))
+            cout << name << " ";
+
+        tree.compactTree(ClusterTree::Compaction::BY_DISTANCE, 0.7);
+        cout << "\nCompacted by distance 0.7: ";
+        for(auto node : tree.current_leaves)
+            cout << tree.getOriginalId(node) << " ";
+
+        tree.compactTree(ClusterTree::Compaction::BY_LEVEL, 0);
+        cout << "\nCompacted by level 0: ";
+        for(auto node : tree.current_leaves)
+            cout << tree.getOriginalId(node) << " ";
+        cout << endl;
     }
     catch(std::exception& e) {
         cerr << "\n***********************************************************"